@@ -0,0 +1,122 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "CoherentSetAssembler.h"
+
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+CoherentSetAssembler::CoherentSetAssembler()
+  : pending_(0)
+{
+}
+
+CoherentSetAssembler::~CoherentSetAssembler()
+{
+  clear();
+}
+
+void
+CoherentSetAssembler::add(ReceivedDataElement* sample,
+                          const SubscriptionInstance_rch& instance)
+{
+  const bool group = !(sample->publisher_id_ == GUID_UNKNOWN);
+  PendingSets& sets = group ? by_publisher_ : by_writer_;
+  PendingSample pending = {sample, instance};
+  sets[group ? sample->publisher_id_ : sample->pub_].push_back(pending);
+  sample->inc_ref();
+  ++pending_;
+}
+
+bool
+CoherentSetAssembler::take_set(const PublicationId& writer,
+                               const RepoId& publisher,
+                               PendingSet& set)
+{
+  const bool group = !(publisher == GUID_UNKNOWN);
+  PendingSets& sets = group ? by_publisher_ : by_writer_;
+  const PendingSets::iterator iter = sets.find(group ? publisher : writer);
+  if (iter == sets.end()) {
+    return false;
+  }
+  set.swap(iter->second);
+  sets.erase(iter);
+  pending_ -= set.size();
+  return true;
+}
+
+void
+CoherentSetAssembler::accept(const PublicationId& writer,
+                             const RepoId& publisher)
+{
+  PendingSet set;
+  if (!take_set(writer, publisher, set)) {
+    return;
+  }
+
+  for (PendingSet::iterator it = set.begin(); it != set.end(); ++it) {
+    // Clearing the flag makes the sample available for read/take.  This is
+    // harmless if the sample was already dropped from its instance.
+    it->sample_->coherent_change_ = false;
+    it->sample_->dec_ref();
+  }
+}
+
+void
+CoherentSetAssembler::reject(const PublicationId& writer,
+                             const RepoId& publisher)
+{
+  PendingSet set;
+  if (!take_set(writer, publisher, set)) {
+    return;
+  }
+
+  for (PendingSet::iterator it = set.begin(); it != set.end(); ++it) {
+    ReceivedDataElementList& samples = it->instance_->rcvd_samples_;
+    const size_t size = samples.size_;
+    samples.remove(it->sample_);
+    if (samples.size_ != size) {
+      // release the instance's reference
+      it->sample_->dec_ref();
+    }
+    it->sample_->dec_ref();
+  }
+}
+
+void
+CoherentSetAssembler::clear()
+{
+  PendingSets* const all[] = {&by_writer_, &by_publisher_};
+  for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+    for (PendingSets::iterator set = all[i]->begin(); set != all[i]->end(); ++set) {
+      for (PendingSet::iterator it = set->second.begin();
+           it != set->second.end(); ++it) {
+        it->sample_->dec_ref();
+      }
+    }
+    all[i]->clear();
+  }
+  pending_ = 0;
+}
+
+size_t
+CoherentSetAssembler::pending() const
+{
+  return pending_;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_OBJECT_MODEL_PROFILE
@@ -0,0 +1,90 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_COHERENTSETASSEMBLER_H
+#define OPENDDS_DCPS_COHERENTSETASSEMBLER_H
+
+#include /**/ "ace/pre.h"
+#include "dcps_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+
+#include "ReceivedDataElementList.h"
+#include "SubscriptionInstance.h"
+#include "GuidUtils.h"
+#include "PoolAllocator.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// Collects the samples of the coherent change sets a DataReader is
+/// receiving, in arrival order, so that completing or rejecting a set only
+/// visits the samples belonging to it instead of every sample of every
+/// instance.  Samples of a GROUP coherent set are keyed by their publisher,
+/// the others by their writer, matching how DataReaderImpl::accept_coherent()
+/// and reject_coherent() identify a set.
+///
+/// The caller must hold the DataReader's sample_lock_.
+class OpenDDS_Dcps_Export CoherentSetAssembler {
+public:
+  CoherentSetAssembler();
+  ~CoherentSetAssembler();
+
+  /// Record a sample that was stored in instance while its coherent set is
+  /// still open.  A reference to the sample is held until the set is
+  /// accepted or rejected.
+  void add(ReceivedDataElement* sample, const SubscriptionInstance_rch& instance);
+
+  /// Make the samples of the set available to read/take.  The set is
+  /// identified by publisher if it's not GUID_UNKNOWN, otherwise by writer.
+  void accept(const PublicationId& writer, const RepoId& publisher);
+
+  /// Remove the samples of the set from their instances.
+  void reject(const PublicationId& writer, const RepoId& publisher);
+
+  /// Release all pending samples without changing them.
+  void clear();
+
+  /// Number of samples waiting for their set to be completed.
+  size_t pending() const;
+
+private:
+  CoherentSetAssembler(const CoherentSetAssembler&);
+  CoherentSetAssembler& operator=(const CoherentSetAssembler&);
+
+  struct PendingSample {
+    ReceivedDataElement* sample_;
+    SubscriptionInstance_rch instance_;
+  };
+  typedef OPENDDS_VECTOR(PendingSample) PendingSet;
+  typedef OPENDDS_MAP_CMP(RepoId, PendingSet, GUID_tKeyLessThan) PendingSets;
+
+  /// Detach the set identified by writer/publisher into set.
+  bool take_set(const PublicationId& writer, const RepoId& publisher,
+                PendingSet& set);
+
+  PendingSets by_writer_;
+  PendingSets by_publisher_;
+  size_t pending_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_OBJECT_MODEL_PROFILE
+
+#include /**/ "ace/post.h"
+
+#endif /* OPENDDS_DCPS_COHERENTSETASSEMBLER_H */
@@ -28,6 +28,7 @@ ContentFilteredTopicImpl::ContentFilteredTopicImpl(const char* name,
   , filter_expression_(filter_expression)
   , filter_eval_(filter_expression, false /*allowOrderBy*/)
   , related_topic_(DDS::Topic::_duplicate(related_topic))
+  , field_ids_meta_(0)
 {
   if (DCPS_debug_level > 5) {
     ACE_DEBUG((LM_DEBUG,
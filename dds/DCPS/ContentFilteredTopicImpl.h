@@ -57,7 +57,18 @@ public:
     if (sample_only_has_key_fields && filter_eval_.has_non_key_fields(meta)) {
       return false;
     }
-    return filter_eval_.eval(s, expression_parameters_);
+    return filter_eval_.eval(s, expression_parameters_, &field_ids(meta));
+  }
+
+  /**
+   * Returns true if the serialized sample matches the filter.
+   */
+  bool filter(ACE_Message_Block* serialized, bool swap_bytes, bool cdr_encap,
+              const MetaStruct& meta) const
+  {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, false);
+    return filter_eval_.eval(serialized, swap_bytes, cdr_encap, meta,
+                             expression_parameters_, &field_ids(meta));
   }
 
   void add_reader(DataReaderImpl& reader);
@@ -69,6 +80,16 @@ public:
   }
 
 private:
+  /// Caller must hold lock_
+  const FilterEvaluator::FieldIds& field_ids(const MetaStruct& meta) const
+  {
+    if (field_ids_meta_ != &meta) {
+      field_ids_ = filter_eval_.getFieldIds(meta);
+      field_ids_meta_ = &meta;
+    }
+    return field_ids_;
+  }
+
   OPENDDS_STRING filter_expression_;
   FilterEvaluator filter_eval_;
   DDS::StringSeq expression_parameters_;
@@ -76,7 +97,11 @@ private:
   typedef OPENDDS_VECTOR(WeakRcHandle<DataReaderImpl>) Readers;
   Readers readers_;
 
-  /// Concurrent access to expression_parameters_ and readers_
+  /// Ids of the filter's fields in the related topic's type
+  mutable FilterEvaluator::FieldIds field_ids_;
+  mutable const MetaStruct* field_ids_meta_;
+
+  /// Concurrent access to expression_parameters_, readers_, and field_ids_
   mutable ACE_Recursive_Thread_Mutex lock_;
 };
 
@@ -11,9 +11,62 @@
 #include "ace/Lock_Adapter_T.h"
 #include "ace/Thread_Mutex.h"
 #include "ace/Containers_T.h"
+#include "ace/OS_NS_Thread.h"
 #include "dcps_export.h"
 #include "dds/DCPS/PoolAllocationBase.h"
 
+#ifdef ACE_HAS_CPP11
+#  include <atomic>
+
+/**
+ * @class DataBlockSpinLock
+ *
+ * @brief ACE_Lock used as the locking strategy of ACE_Data_Blocks.
+ *
+ * ACE_Data_Block only holds its locking strategy around the update of
+ * its reference count, so acquiring the lock is a single atomic
+ * exchange and releasing it a single store.  Contention is resolved
+ * by yielding instead of blocking in the kernel.
+ */
+class DataBlockSpinLock : public ACE_Lock {
+public:
+  DataBlockSpinLock()
+  {
+    flag_.clear();
+  }
+
+  virtual int remove() { return 0; }
+
+  virtual int acquire()
+  {
+    while (flag_.test_and_set(std::memory_order_acquire)) {
+      ACE_OS::thr_yield();
+    }
+    return 0;
+  }
+
+  virtual int tryacquire()
+  {
+    return flag_.test_and_set(std::memory_order_acquire) ? -1 : 0;
+  }
+
+  virtual int release()
+  {
+    flag_.clear(std::memory_order_release);
+    return 0;
+  }
+
+  virtual int acquire_read() { return acquire(); }
+  virtual int acquire_write() { return acquire(); }
+  virtual int tryacquire_read() { return tryacquire(); }
+  virtual int tryacquire_write() { return tryacquire(); }
+  virtual int tryacquire_write_upgrade() { return 0; }
+
+private:
+  std::atomic_flag flag_;
+};
+#endif
+
 /**
  * @class DataBlockLockPool
  *
@@ -27,7 +80,11 @@
  */
 class OpenDDS_Dcps_Export DataBlockLockPool : public OpenDDS::DCPS::PoolAllocationBase {
 public:
+#ifdef ACE_HAS_CPP11
+  typedef DataBlockSpinLock DataBlockLock;
+#else
   typedef ACE_Lock_Adapter<ACE_Thread_Mutex> DataBlockLock;
+#endif
 
   DataBlockLockPool(unsigned long size)
     : pool_(size),
@@ -59,6 +59,10 @@ DataReaderImpl::DataReaderImpl()
 #endif
   coherent_(false),
   subqos_ (TheServiceParticipant->initial_SubscriberQos()),
+  lazy_deserialization_(false),
+  recycle_samples_(false),
+  historic_batch_depth_(0),
+  historic_data_pending_(false),
   topic_desc_(0),
   listener_mask_(DEFAULT_STATUS_MASK),
   domain_id_(0),
@@ -2660,6 +2664,12 @@ DataReaderImpl::ownership_filter_instance(const SubscriptionInstance_rch& instan
       return true;
     }
 
+    // Fast path: the instance ownership slot already names this writer
+    // at its current strength, no need to consult the OwnershipManager.
+    if (instance->instance_state_.is_owner(
+          pubid, iter->second->writer_qos_.ownership_strength.value)) {
+      return false;
+    }
 
     // Evaulate the owner of the instance if not selected and filter
     // current message if it's not from owner writer.
@@ -2716,6 +2726,20 @@ DataReaderImpl::time_based_filter_instance(const SubscriptionInstance_rch& insta
 {
   ACE_Time_Value now(ACE_OS::gettimeofday());
 
+  if (time_based_filter_pending(instance, now, filter_time_expired)) {
+    return true;  // Data filtered.
+  }
+
+  instance->last_accepted_ = now;
+
+  return false;
+}
+
+bool
+DataReaderImpl::time_based_filter_pending(const SubscriptionInstance_rch& instance,
+                                          const ACE_Time_Value& now,
+                                          ACE_Time_Value& filter_time_expired) const
+{
   // TIME_BASED_FILTER processing; expire data samples
   // if minimum separation is not met for instance.
   const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
@@ -2725,12 +2749,10 @@ DataReaderImpl::time_based_filter_instance(const SubscriptionInstance_rch& insta
     DDS::Duration_t separation = time_value_to_duration(filter_time_expired);
 
     if (separation < qos_.time_based_filter.minimum_separation) {
-      return true;  // Data filtered.
+      return true;
     }
   }
 
-  instance->last_accepted_ = now;
-
   return false;
 }
 
@@ -2846,6 +2868,16 @@ DataReaderImpl::get_topic_id()
   return this->topic_servant_->get_id();
 }
 
+OPENDDS_STRING
+DataReaderImpl::transport_topic_name() const
+{
+  if (!topic_servant_) {
+    return OPENDDS_STRING();
+  }
+  const CORBA::String_var name = topic_servant_->get_name();
+  return name.in();
+}
+
 OpenDDS::DCPS::RepoId
 DataReaderImpl::get_dp_id()
 {
@@ -2965,13 +2997,7 @@ void DataReaderImpl::accept_coherent (PublicationId& writer_id,
   }
 
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, this->instances_lock_);
-
-  for (SubscriptionInstanceMapType::iterator iter = this->instances_.begin();
-      iter != this->instances_.end(); ++iter) {
-    iter->second->rcvd_strategy_->accept_coherent(
-        writer_id, publisher_id);
-  }
+  coherent_sets_.accept(writer_id, publisher_id);
 }
 
 
@@ -2991,13 +3017,7 @@ void DataReaderImpl::reject_coherent (PublicationId& writer_id,
   }
 
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, this->instances_lock_);
-
-  for (SubscriptionInstanceMapType::iterator iter = this->instances_.begin();
-      iter != this->instances_.end(); ++iter) {
-    iter->second->rcvd_strategy_->reject_coherent(
-        writer_id, publisher_id);
-  }
+  coherent_sets_.reject(writer_id, publisher_id);
   this->reset_coherent_info (writer_id, publisher_id);
 }
 
@@ -3233,12 +3253,55 @@ bool DataReaderImpl::check_historic(const ReceivedDataSample& sample)
 
 void DataReaderImpl::deliver_historic(OPENDDS_MAP(SequenceNumber, ReceivedDataSample)& samples)
 {
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+    ++historic_batch_depth_;
+  }
+
   typedef OPENDDS_MAP(SequenceNumber, ReceivedDataSample)::iterator iter_t;
   const iter_t end = samples.end();
   for (iter_t iter = samples.begin(); iter != end; ++iter) {
     iter->second.header_.historic_sample_ = true;
     data_received(iter->second);
   }
+
+  // The whole history was stored without per-sample notifications,
+  // let the application know about it once, the same way
+  // finish_store_instance_data() notifies a single sample.
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+  if (--historic_batch_depth_ != 0 || !historic_data_pending_) {
+    return;
+  }
+  historic_data_pending_ = false;
+
+  RcHandle<SubscriberImpl> sub = get_subscriber_servant();
+  if (!sub)
+    return;
+
+  sub->set_status_changed_flag(::DDS::DATA_ON_READERS_STATUS, true);
+  set_status_changed_flag(::DDS::DATA_AVAILABLE_STATUS, true);
+
+  ::DDS::SubscriberListener_var sub_listener =
+      sub->listener_for(::DDS::DATA_ON_READERS_STATUS);
+  if (!CORBA::is_nil(sub_listener.in()) && !this->coherent_) {
+    ACE_GUARD(Reverse_Lock_t, unlock_guard, reverse_sample_lock_);
+    sub_listener->on_data_on_readers(sub.in());
+    sub->set_status_changed_flag(::DDS::DATA_ON_READERS_STATUS, false);
+  } else {
+    sub->notify_status_condition();
+
+    ::DDS::DataReaderListener_var listener =
+        listener_for(::DDS::DATA_AVAILABLE_STATUS);
+    if (!CORBA::is_nil(listener.in())) {
+      ACE_GUARD(Reverse_Lock_t, unlock_guard, reverse_sample_lock_);
+      listener->on_data_available(this);
+      set_status_changed_flag(::DDS::DATA_AVAILABLE_STATUS, false);
+      sub->set_status_changed_flag(::DDS::DATA_ON_READERS_STATUS, false);
+    } else {
+      ACE_GUARD(Reverse_Lock_t, unlock_guard, reverse_sample_lock_);
+      notify_status_condition();
+    }
+  }
 }
 
 void
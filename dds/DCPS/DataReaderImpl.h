@@ -29,6 +29,7 @@
 #include "ContentFilteredTopicImpl.h"
 #include "MultiTopicImpl.h"
 #include "GroupRakeData.h"
+#include "CoherentSetAssembler.h"
 #include "CoherentChangeControl.h"
 #include "AssociationData.h"
 #include "dds/DdsDcpsInfrastructureC.h"
@@ -355,6 +356,20 @@ public:
 
   /// @}
 
+  /// Configure deferred deserialization: received samples are stored
+  /// serialized and only demarshaled when they are read or taken (or
+  /// evaluated by a QueryCondition).  This saves the deserialization of
+  /// samples that are replaced in the history before being accessed.
+  /// Should be set before the reader is enabled.
+  bool& lazy_deserialization();
+
+  /// Configure sample recycling: released samples (once taken and returned,
+  /// or removed from the history) are kept and the next samples are
+  /// demarshaled into them, reusing the buffers of their strings and
+  /// sequences when the new values fit.  Should be set before the reader
+  /// is enabled.
+  bool& recycle_samples();
+
   /// update liveliness info for this writer.
   void writer_activity(const DataSampleHeader& header);
 
@@ -616,6 +631,12 @@ protected:
   bool time_based_filter_instance(const SubscriptionInstance_rch& instance,
                                   ACE_Time_Value& filter_time_expired);
 
+  /// Check the TIME_BASED_FILTER of the instance without accepting a
+  /// sample, used to filter samples before they are demarshaled.
+  bool time_based_filter_pending(const SubscriptionInstance_rch& instance,
+                                 const ACE_Time_Value& now,
+                                 ACE_Time_Value& filter_time_expired) const;
+
   void accept_sample_processing(const SubscriptionInstance_rch& instance, const DataSampleHeader& header, bool is_new_instance);
 
   virtual void qos_change(const DDS::DataReaderQos& qos);
@@ -658,8 +679,27 @@ protected:
   /// Ordered group samples.
   GroupRakeData group_coherent_ordered_data_;
 
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+  /// Samples of coherent change sets that are not complete yet.
+  CoherentSetAssembler coherent_sets_;
+#endif
+
   DDS::SubscriberQos subqos_;
 
+  /// Defer the deserialization of samples until they are accessed.
+  bool lazy_deserialization_;
+
+  /// Demarshal samples into previously released ones.
+  bool recycle_samples_;
+
+  /// Nesting depth of deliver_historic(); while non-zero the per-sample
+  /// DATA_AVAILABLE notification of historic samples is deferred to the
+  /// end of the batch.  Live samples are notified as they arrive.
+  int historic_batch_depth_;
+
+  /// Set when a historic batch stored data it has not notified yet.
+  bool historic_data_pending_;
+
 protected:
   virtual void add_link(const DataLink_rch& link, const RepoId& peer);
 
@@ -686,6 +726,9 @@ private:
     return data.publication_transport_priority_;
   }
 
+  OPENDDS_STRING transport_topic_name() const;
+  RepoId transport_participant_id() const { return dp_id_; }
+
 #if defined(OPENDDS_SECURITY)
   DDS::Security::ParticipantCryptoHandle get_crypto_handle() const;
 #endif
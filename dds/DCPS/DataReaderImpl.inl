@@ -28,6 +28,20 @@ OpenDDS::DCPS::DataReaderImpl::raw_latency_buffer_type()
   return this->raw_latency_buffer_type_;
 }
 
+ACE_INLINE
+bool&
+OpenDDS::DCPS::DataReaderImpl::lazy_deserialization()
+{
+  return this->lazy_deserialization_;
+}
+
+ACE_INLINE
+bool&
+OpenDDS::DCPS::DataReaderImpl::recycle_samples()
+{
+  return this->recycle_samples_;
+}
+
 ACE_INLINE
 void
 OpenDDS::DCPS::DataReaderImpl::disable_transport()
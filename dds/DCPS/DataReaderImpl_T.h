@@ -57,6 +57,10 @@ namespace OpenDDS {
       void operator delete(void* memory, ACE_New_Allocator& pool);
       void operator delete(void* memory);
 
+      /// Give sample back to the SampleCache of its DataReader if it has
+      /// one with room left, otherwise delete it.
+      static void release(MessageTypeWithAllocator* sample);
+
       MessageTypeWithAllocator(){}
       MessageTypeWithAllocator(const MessageType& other)
         : MessageType(other)
@@ -64,9 +68,71 @@ namespace OpenDDS {
       }
     };
 
+    /// Released samples kept constructed, the next samples are demarshaled
+    /// into them (see DataReaderImpl::recycle_samples()).
+    class SampleCache {
+    public:
+      explicit SampleCache(size_t max_samples)
+        : max_samples_(max_samples)
+      {
+      }
+
+      ~SampleCache()
+      {
+        for (size_t i = 0; i < samples_.size(); ++i) {
+          delete samples_[i];
+        }
+      }
+
+      MessageTypeWithAllocator* get()
+      {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+        if (samples_.empty()) {
+          return 0;
+        }
+        MessageTypeWithAllocator* const sample = samples_.back();
+        samples_.pop_back();
+        return sample;
+      }
+
+      bool put(MessageTypeWithAllocator* sample)
+      {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+        if (samples_.size() >= max_samples_) {
+          return false;
+        }
+        samples_.push_back(sample);
+        return true;
+      }
+
+    private:
+      ACE_Thread_Mutex lock_;
+      OPENDDS_VECTOR(MessageTypeWithAllocator*) samples_;
+      const size_t max_samples_;
+    };
+
+    /// Passes a sample that wasn't stored to MessageTypeWithAllocator::release()
+    /// when leaving the scope, instead of deleting it.
+    class SampleReleaser {
+    public:
+      explicit SampleReleaser(unique_ptr<MessageTypeWithAllocator>& sample)
+        : sample_(sample)
+      {
+      }
+
+      ~SampleReleaser()
+      {
+        MessageTypeWithAllocator::release(sample_.release());
+      }
+
+    private:
+      unique_ptr<MessageTypeWithAllocator>& sample_;
+    };
+
     struct MessageTypeMemoryBlock {
       MessageTypeWithAllocator element_;
       ACE_New_Allocator* allocator_;
+      SampleCache* cache_;
     };
 
     typedef OpenDDS::DCPS::Cached_Allocator_With_Overflow<MessageTypeMemoryBlock, ACE_Null_Mutex>  DataAllocator;
@@ -80,6 +146,10 @@ namespace OpenDDS {
 
     virtual ~DataReaderImpl_T (void)
     {
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+      // Pending samples must be released while the allocators are alive.
+      this->coherent_sets_.clear();
+#endif
       for (typename InstanceMap::iterator it = instance_map_.begin();
            it != instance_map_.end(); ++it)
         {
@@ -96,6 +166,9 @@ namespace OpenDDS {
     virtual DDS::ReturnCode_t enable_specific ()
     {
       data_allocator().reset(new DataAllocator(get_n_chunks ()));
+      if (recycle_samples_) {
+        sample_cache().reset(new SampleCache(get_n_chunks ()));
+      }
       if (OpenDDS::DCPS::DCPS_debug_level >= 2)
         ACE_DEBUG((LM_DEBUG,
                    ACE_TEXT("(%P|%t) %CDataReaderImpl::")
@@ -257,6 +330,7 @@ namespace OpenDDS {
 
                 if (item->sample_state_ & DDS::NOT_READ_SAMPLE_STATE)
                   {
+                    item->deserialize();
                     if (item->registered_data_ != 0)
                       {
                         received_data =
@@ -334,6 +408,7 @@ namespace OpenDDS {
 #endif
                 if (item->sample_state_ & DDS::NOT_READ_SAMPLE_STATE)
                   {
+                    item->deserialize();
                     if (item->registered_data_ != 0)
                       {
                         received_data =
@@ -751,6 +826,7 @@ namespace OpenDDS {
               && !item->coherent_change_
 #endif
               && item->registered_data_) {
+            item->deserialize();
             if (!item->valid_data_ && filter_has_non_key_fields) {
               continue;
             }
@@ -1019,7 +1095,16 @@ protected:
                              bool & filtered,
                              OpenDDS::DCPS::MarshalingType marshaling_type)
   {
-    unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    if (lazy_deserialization_
+        && marshaling_type == OpenDDS::DCPS::FULL_MARSHALING
+        && sample.header_.message_id_ == OpenDDS::DCPS::SAMPLE_DATA) {
+      lazy_demarshal(sample, instance, just_registered, filtered);
+      return;
+    }
+
+    unique_ptr<MessageTypeWithAllocator> data(
+      marshaling_type == OpenDDS::DCPS::FULL_MARSHALING
+      ? new_sample() : new (*data_allocator()) MessageTypeWithAllocator);
     const bool cdr = sample.header_.cdr_encapsulation_;
 
     OpenDDS::DCPS::Serializer ser(
@@ -1044,6 +1129,30 @@ protected:
 
     if (marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING) {
       ser >> OpenDDS::DCPS::KeyOnly< MessageType>(*data);
+    } else if (sample.header_.message_id_ == OpenDDS::DCPS::SAMPLE_DATA
+               && time_based_prefilter_applies(sample)) {
+      // Only the members up to the last key are needed to find the
+      // instance, the rest is demarshaled if the sample is kept.
+      DDS::InstanceHandle_t handle = DDS::HANDLE_NIL;
+      ACE_Time_Value filter_time_expired;
+      if ((ser >> OpenDDS::DCPS::KeyPrefix<MessageType>(*data))
+          && time_based_prefilter(*data, handle, filter_time_expired)) {
+        filtered = true;
+        if (qos_.reliability.kind == DDS::RELIABLE_RELIABILITY_QOS) {
+          // The latest filtered sample is delivered at the end of the
+          // filter period.
+          if (ser >> OpenDDS::DCPS::KeySuffix<MessageType>(*data)) {
+            filter_delayed_handler_->delay_sample(handle, move(data), sample.header_,
+                                                  false, filter_time_expired);
+            return;
+          }
+        } else {
+          MessageTypeWithAllocator::release(data.release());
+          return;
+        }
+      } else if (ser.good_bit()) {
+        ser >> OpenDDS::DCPS::KeySuffix<MessageType>(*data);
+      }
     } else {
       ser >> *data;
     }
@@ -1052,6 +1161,7 @@ protected:
       ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::dds_demarshal ")
                  ACE_TEXT("deserialization failed, dropping sample.\n"),
                  TraitsType::type_name()));
+      MessageTypeWithAllocator::release(data.release());
       return;
     }
 
@@ -1063,6 +1173,7 @@ protected:
         const MessageType& type = static_cast<MessageType&>(*data);
         if (!content_filtered_topic_->filter(type, sample_only_has_key_fields)) {
           filtered = true;
+          MessageTypeWithAllocator::release(data.release());
           return;
         }
       }
@@ -1072,6 +1183,164 @@ protected:
     store_instance_data(move(data), sample.header_, instance, just_registered, filtered);
   }
 
+  /// A sample to demarshal into, one from the SampleCache if there is one.
+  MessageTypeWithAllocator* new_sample()
+  {
+    SampleCache* const cache = sample_cache().get();
+    MessageTypeWithAllocator* sample = cache ? cache->get() : 0;
+    if (!sample) {
+      sample = new (*data_allocator()) MessageTypeWithAllocator;
+      reinterpret_cast<MessageTypeMemoryBlock*>(sample)->cache_ = cache;
+    }
+    return sample;
+  }
+
+  /// Store a sample without demarshaling all of it, only the members up
+  /// to the last key are extracted to find its instance.  The rest is
+  /// demarshaled when the sample is first read or taken, so samples that
+  /// are replaced in the history before that are never demarshaled.
+  void lazy_demarshal(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                      OpenDDS::DCPS::SubscriptionInstance_rch& instance,
+                      bool& just_registered,
+                      bool& filtered)
+  {
+    const bool swap = sample.header_.byte_order_ != ACE_CDR_BYTE_ORDER;
+    const bool cdr = sample.header_.cdr_encapsulation_;
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    if (!sample.header_.content_filter_ && content_filtered_topic_
+        && !content_filtered_topic_->filter(sample.sample_.get(), swap, cdr,
+                                            getMetaStruct<MessageType>())) {
+      filtered = true;
+      return;
+    }
+#endif
+
+    OpenDDS::DCPS::ReceivedDataSample dup(sample);
+    OpenDDS::DCPS::Serializer ser(
+      dup.sample_.get(), swap,
+      cdr ? OpenDDS::DCPS::Serializer::ALIGN_CDR
+          : OpenDDS::DCPS::Serializer::ALIGN_NONE);
+
+    if (cdr) {
+      ACE_CDR::ULong header;
+      if (!(ser >> header)) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::lazy_demarshal ")
+                  ACE_TEXT("deserialization header failed, dropping sample.\n"),
+                  TraitsType::type_name()));
+        return;
+      }
+
+      if (Serializer::use_rti_serialization()) {
+        // Start counting byte-offset AFTER header
+        ser.reset_alignment();
+      }
+    }
+
+    unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    if (!(ser >> OpenDDS::DCPS::KeyPrefix<MessageType>(*data))) {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::lazy_demarshal ")
+                 ACE_TEXT("deserialization failed, dropping sample.\n"),
+                 TraitsType::type_name()));
+      return;
+    }
+
+    store_instance_data(move(data), sample.header_, instance, just_registered,
+                        filtered, &sample);
+  }
+
+  /// Whether the TIME_BASED_FILTER of a sample can be checked before
+  /// it is fully demarshaled (see time_based_prefilter()).  Samples that
+  /// still need ownership filtering, and samples a RELIABLE reader would
+  /// have to content filter before delaying them, take the regular path.
+  bool time_based_prefilter_applies(const OpenDDS::DCPS::ReceivedDataSample& sample) const
+  {
+    const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
+    if (!(qos_.time_based_filter.minimum_separation > zero)) {
+      return false;
+    }
+
+#ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
+    if (is_exclusive_ownership_) {
+      return false;
+    }
+#endif
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    if (qos_.reliability.kind == DDS::RELIABLE_RELIABILITY_QOS
+        && content_filtered_topic_ && !sample.header_.content_filter_) {
+      return false;
+    }
+#else
+    ACE_UNUSED_ARG(sample);
+#endif
+
+    return true;
+  }
+
+  /// Apply the TIME_BASED_FILTER to a sample of which only the members
+  /// up to the last key are demarshaled.  Returns true if the sample is
+  /// filtered, then handle and filter_time_expired are set for a RELIABLE
+  /// reader to delay it.  Samples of new instances are left to the
+  /// regular path.
+  bool time_based_prefilter(const MessageType& key,
+                            DDS::InstanceHandle_t& handle,
+                            ACE_Time_Value& filter_time_expired)
+  {
+    //!!! caller should already have the sample_lock_
+
+    typename InstanceMap::const_iterator const it = instance_map_.find(key);
+    if (it == instance_map_.end()) {
+      return false;
+    }
+
+    OpenDDS::DCPS::SubscriptionInstance_rch instance = get_handle_instance(it->second);
+    if (!instance
+        || !time_based_filter_pending(instance, ACE_OS::gettimeofday(),
+                                      filter_time_expired)) {
+      return false;
+    }
+
+    handle = it->second;
+    return true;
+  }
+
+  /// Demarshal a sample that was delayed before it was demarshaled.
+  bool demarshal_delayed(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                         unique_ptr<MessageTypeWithAllocator>& data)
+  {
+    OpenDDS::DCPS::ReceivedDataSample dup(sample);
+    const bool cdr = dup.header_.cdr_encapsulation_;
+
+    OpenDDS::DCPS::Serializer ser(
+      dup.sample_.get(),
+      dup.header_.byte_order_ != ACE_CDR_BYTE_ORDER,
+      cdr ? OpenDDS::DCPS::Serializer::ALIGN_CDR
+          : OpenDDS::DCPS::Serializer::ALIGN_NONE);
+
+    if (cdr) {
+      ACE_CDR::ULong header;
+      if (!(ser >> header)) {
+        return false;
+      }
+
+      if (Serializer::use_rti_serialization()) {
+        // Start counting byte-offset AFTER header
+        ser.reset_alignment();
+      }
+    }
+
+    data.reset(new (*data_allocator()) MessageTypeWithAllocator);
+    if (!(ser >> *data)) {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) %CDataReaderImpl::demarshal_delayed ")
+                 ACE_TEXT("deserialization failed, dropping sample.\n"),
+                 TraitsType::type_name()));
+      data.reset();
+      return false;
+    }
+    return true;
+  }
+
   virtual void dispose_unregister(const OpenDDS::DCPS::ReceivedDataSample& sample,
                                   OpenDDS::DCPS::SubscriptionInstance_rch& instance)
   {
@@ -1607,13 +1876,19 @@ DDS::ReturnCode_t take_next_instance_i (
   return DDS::RETCODE_NO_DATA;
 }
 
+/// If 'serialized' is not null, instance_data only holds the members up
+/// to the last key and the rest is demarshaled from 'serialized' later.
 void store_instance_data(
                          unique_ptr<MessageTypeWithAllocator> instance_data,
                          const OpenDDS::DCPS::DataSampleHeader& header,
                          OpenDDS::DCPS::SubscriptionInstance_rch& instance_ptr,
                          bool & just_registered,
-                         bool & filtered)
+                         bool & filtered,
+                         const OpenDDS::DCPS::ReceivedDataSample* serialized = 0)
 {
+  // rejected, filtered or registration-only samples go back to the cache
+  SampleReleaser releaser(instance_data);
+
   const bool is_dispose_msg =
     header.message_id_ == OpenDDS::DCPS::DISPOSE_INSTANCE ||
     header.message_id_ == OpenDDS::DCPS::DISPOSE_UNREGISTER_INSTANCE;
@@ -1792,8 +2067,11 @@ void store_instance_data(
           time_based_filter_instance(instance_ptr, filter_time_expired)) {
         filtered = true;
         if (this->qos_.reliability.kind == DDS::RELIABLE_RELIABILITY_QOS) {
-          filter_delayed_handler_->delay_sample(handle, move(instance_data), header, just_registered, filter_time_expired);
-
+          if (serialized) {
+            filter_delayed_handler_->delay_serialized_sample(handle, *serialized, filter_time_expired, just_registered);
+          } else {
+            filter_delayed_handler_->delay_sample(handle, move(instance_data), header, just_registered, filter_time_expired);
+          }
         }
       } else {
         // nothing time based filtered now
@@ -1807,7 +2085,7 @@ void store_instance_data(
       }
     }
 
-    finish_store_instance_data(move(instance_data), header, instance_ptr, is_dispose_msg, is_unregister_msg);
+    finish_store_instance_data(move(instance_data), header, instance_ptr, is_dispose_msg, is_unregister_msg, serialized);
   }
   else
   {
@@ -1817,8 +2095,11 @@ void store_instance_data(
 }
 
 void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data, const DataSampleHeader& header,
-  SubscriptionInstance_rch instance_ptr, bool is_dispose_msg, bool is_unregister_msg )
+  SubscriptionInstance_rch instance_ptr, bool is_dispose_msg, bool is_unregister_msg,
+  const OpenDDS::DCPS::ReceivedDataSample* serialized = 0)
 {
+  SampleReleaser releaser(instance_data);
+
   if ((this->qos_.resource_limits.max_samples_per_instance !=
         DDS::LENGTH_UNLIMITED) &&
       (instance_ptr->rcvd_samples_.size_ >=
@@ -1952,6 +2233,17 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
   OpenDDS::DCPS::ReceivedDataElement *ptr =
     new (*rd_allocator_.get()) OpenDDS::DCPS::ReceivedDataElementWithType<MessageTypeWithAllocator>(header,instance_data.release(), &this->sample_lock_);
 
+  if (serialized) {
+    // Copy the payload out of the transport's receive buffer so that the
+    // buffer isn't held as long as the sample stays in the history.
+    ptr->serialized_.reset(new ACE_Message_Block(serialized->sample_->total_length()));
+    for (const ACE_Message_Block* mb = serialized->sample_.get(); mb; mb = mb->cont()) {
+      ptr->serialized_->copy(mb->rd_ptr(), mb->length());
+    }
+    ptr->serialized_swap_ = header.byte_order_ != ACE_CDR_BYTE_ORDER;
+    ptr->serialized_cdr_ = header.cdr_encapsulation_;
+  }
+
   ptr->disposed_generation_count_ =
     instance_ptr->instance_state_.disposed_generation_count();
   ptr->no_writers_generation_count_ =
@@ -1961,6 +2253,12 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
 
   instance_ptr->rcvd_strategy_->add(ptr);
 
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+  if (ptr->coherent_change_) {
+    this->coherent_sets_.add(ptr, instance_ptr);
+  }
+#endif
+
   if (! is_dispose_msg  && ! is_unregister_msg
       && instance_ptr->rcvd_samples_.size_ > get_depth())
     {
@@ -1997,6 +2295,13 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   if (! ptr->coherent_change_) {
 #endif
+    if (historic_batch_depth_ && header.historic_sample_) {
+      // deliver_historic() notifies once for the whole batch, live samples
+      // of other writers stored meanwhile are notified as usual.
+      historic_data_pending_ = true;
+      return;
+    }
+
     RcHandle<OpenDDS::DCPS::SubscriberImpl> sub = get_subscriber_servant ();
     if (!sub)
       return;
@@ -2174,6 +2479,62 @@ public:
                     const OpenDDS::DCPS::DataSampleHeader& header,
                     const bool just_registered,
                     const ACE_Time_Value& filter_time_expired)
+  {
+    delay(handle, move(data), OpenDDS::DCPS::ReceivedDataSample(0), header,
+          just_registered, filter_time_expired);
+  }
+
+  /// Same as delay_sample() for a sample that has not been demarshaled
+  /// yet, it is only demarshaled if it is still the most recently
+  /// filtered sample of the instance when the filter period expires.
+  void delay_serialized_sample(DDS::InstanceHandle_t handle,
+                               const OpenDDS::DCPS::ReceivedDataSample& sample,
+                               const ACE_Time_Value& filter_time_expired,
+                               const bool just_registered = false)
+  {
+    delay(handle, unique_ptr<MessageTypeWithAllocator>(), sample,
+          sample.header_, just_registered, filter_time_expired);
+  }
+
+  void clear_sample(DDS::InstanceHandle_t handle)
+  {
+    // sample_lock_ should already be held
+
+    typename FilterDelayedSampleMap::iterator sample = map_.find(handle);
+    if (sample != map_.end()) {
+      // leave the entry in the container, so that the key remains valid if the reactor is waiting on this lock while this is occurring
+      sample->second.message.reset();
+      sample->second.serialized.sample_.reset();
+    }
+  }
+
+  void drop_sample(DDS::InstanceHandle_t handle)
+  {
+    // sample_lock_ should already be held
+
+    typename FilterDelayedSampleMap::iterator sample = map_.find(handle);
+    if (sample != map_.end()) {
+      {
+        RcHandle<DataReaderImpl_T<MessageType> > data_reader_impl(data_reader_impl_.lock());
+        if (data_reader_impl) {
+          ACE_GUARD(Reverse_Lock_t, unlock_guard, data_reader_impl->reverse_sample_lock_);
+          cancel_timer(sample->second.timer_id);
+        }
+      }
+
+      // use the handle to erase, since the sample lock was released
+      map_.erase(handle);
+    }
+  }
+
+private:
+
+  void delay(DDS::InstanceHandle_t handle,
+             unique_ptr<MessageTypeWithAllocator> data,
+             const OpenDDS::DCPS::ReceivedDataSample& serialized,
+             const OpenDDS::DCPS::DataSampleHeader& header,
+             const bool just_registered,
+             const ACE_Time_Value& filter_time_expired)
   {
     // sample_lock_ should already be held
     RcHandle<DataReaderImpl_T<MessageType> > data_reader_impl(data_reader_impl_.lock());
@@ -2182,8 +2543,6 @@ public:
       return;
     }
 
-    MessageTypeWithAllocator* instance_data = data.get();
-
     DataSampleHeader_ptr hdr(new OpenDDS::DCPS::DataSampleHeader(header));
 
     typename FilterDelayedSampleMap::iterator i = map_.find(handle);
@@ -2195,9 +2554,9 @@ public:
 #ifdef ACE_HAS_CPP11
       map_.emplace(std::piecewise_construct,
                    std::forward_as_tuple(handle),
-                   std::forward_as_tuple(move(data), hdr, just_registered));
+                   std::forward_as_tuple(move(data), serialized, hdr, just_registered));
 #else
-      map_.insert(std::make_pair(handle, FilterDelayedSample(move(data), hdr, just_registered)));
+      map_.insert(std::make_pair(handle, FilterDelayedSample(move(data), serialized, hdr, just_registered)));
 #endif
       FilterDelayedSample& sample = result.first->second;
 
@@ -2216,7 +2575,7 @@ public:
       }
 
       // ensure that another sample has not replaced this while the lock was released
-      if (instance_data == sample.message.get()) {
+      if (hdr.get() == sample.header.get()) {
         sample.timer_id = timer_id;
       }
     } else {
@@ -2224,46 +2583,13 @@ public:
       // we only care about the most recently filtered sample, so clean up the last one
 
       sample.message = move(data);
+      sample.serialized = serialized;
       sample.header = hdr;
       sample.new_instance = just_registered;
       // already scheduled for timeout at the desired time
     }
   }
 
-  void clear_sample(DDS::InstanceHandle_t handle)
-  {
-    // sample_lock_ should already be held
-
-    typename FilterDelayedSampleMap::iterator sample = map_.find(handle);
-    if (sample != map_.end()) {
-      // leave the entry in the container, so that the key remains valid if the reactor is waiting on this lock while this is occurring
-      sample->second.message.reset();
-    }
-  }
-
-  void drop_sample(DDS::InstanceHandle_t handle)
-  {
-    // sample_lock_ should already be held
-
-    typename FilterDelayedSampleMap::iterator sample = map_.find(handle);
-    if (sample != map_.end()) {
-      {
-        RcHandle<DataReaderImpl_T<MessageType> > data_reader_impl(data_reader_impl_.lock());
-        if (data_reader_impl) {
-          ACE_GUARD(Reverse_Lock_t, unlock_guard, data_reader_impl->reverse_sample_lock_);
-          cancel_timer(sample->second.timer_id);
-        }
-      }
-
-      // use the handle to erase, since the sample lock was released
-      map_.erase(handle);
-    }
-  }
-
-private:
-
-
-
   int handle_timeout(const ACE_Time_Value&, const void* act)
   {
     DDS::InstanceHandle_t handle = static_cast<DDS::InstanceHandle_t>(reinterpret_cast<intptr_t>(act));
@@ -2287,6 +2613,14 @@ private:
         return 0;
       }
 
+      if (!data->second.message && data->second.serialized.sample_) {
+        unique_ptr<MessageTypeWithAllocator> message;
+        if (data_reader_impl->demarshal_delayed(data->second.serialized, message)) {
+          data->second.message = move(message);
+        }
+        data->second.serialized.sample_.reset();
+      }
+
       if (data->second.message) {
         const bool NOT_DISPOSE_MSG = false;
         const bool NOT_UNREGISTER_MSG = false;
@@ -2353,14 +2687,20 @@ private:
 
   struct FilterDelayedSample {
 
-    FilterDelayedSample(unique_ptr<MessageTypeWithAllocator> msg, DataSampleHeader_ptr hdr, bool new_inst)
+    FilterDelayedSample(unique_ptr<MessageTypeWithAllocator> msg,
+                        const OpenDDS::DCPS::ReceivedDataSample& ser,
+                        DataSampleHeader_ptr hdr, bool new_inst)
     : message(move(msg))
+    , serialized(ser)
     , header(hdr)
     , new_instance(new_inst)
     , timer_id(-1) {
     }
 
     container_supported_unique_ptr<MessageTypeWithAllocator> message;
+    /// Set instead of message when the sample was filtered before it
+    /// was demarshaled.
+    OpenDDS::DCPS::ReceivedDataSample serialized;
     DataSampleHeader_ptr header;
     bool new_instance;
     long timer_id;
@@ -2375,10 +2715,16 @@ public:
   //We put the data_allocator_ inside FilterDelayedHandler because the reactor thread in FilterDelayedHandler may be still alive
   // after the containing DataReaderImpl is destroyed. This avoids access violation during cleanup.
   unique_ptr<DataAllocator> data_allocator_;
+
+  typedef typename DataReaderImpl_T<MessageType>::SampleCache SampleCache;
+  // Declared after data_allocator_, which its samples are returned to.
+  unique_ptr<SampleCache> sample_cache_;
 };
 
 unique_ptr<DataAllocator>& data_allocator() { return filter_delayed_handler_->data_allocator_; }
 
+unique_ptr<SampleCache>& sample_cache() { return filter_delayed_handler_->sample_cache_; }
+
 RcHandle<FilterDelayedHandler> filter_delayed_handler_;
 
 InstanceMap  instance_map_;
@@ -2391,6 +2737,7 @@ void* DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::operator new(size
   MessageTypeMemoryBlock* block =
     static_cast<MessageTypeMemoryBlock*>(pool.malloc(sizeof(MessageTypeMemoryBlock)));
   block->allocator_ = &pool;
+  block->cache_ = 0;
   return block;
 }
 
@@ -2403,6 +2750,18 @@ void DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::operator delete(vo
   }
 }
 
+template <typename MessageType>
+void DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::release(MessageTypeWithAllocator* sample)
+{
+  if (sample) {
+    MessageTypeMemoryBlock* block = reinterpret_cast<MessageTypeMemoryBlock*>(sample);
+    if (block->cache_ && block->cache_->put(sample)) {
+      return;
+    }
+    delete sample;
+  }
+}
+
 template <typename MessageType>
 void DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::operator delete(void* memory, ACE_New_Allocator&)
 {
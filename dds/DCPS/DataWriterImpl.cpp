@@ -10,6 +10,7 @@
 #include "FeatureDisabledQosCheck.h"
 #include "DomainParticipantImpl.h"
 #include "PublisherImpl.h"
+#include "PublicationThreadPool.h"
 #include "Service_Participant.h"
 #include "GuidConverter.h"
 #include "TopicImpl.h"
@@ -51,6 +52,16 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+namespace {
+  /// Fraction of a BEST_EFFORT reader's minimum_separation the writer
+  /// keeps between samples of an instance it sends to that reader.  The
+  /// reader filters on reception time, the margin keeps latency jitter
+  /// from making it discard every sample the writer sends.
+  const double TIME_BASED_FILTER_MARGIN = 0.5;
+}
+#endif
+
 //TBD - add check for enabled in most methods.
 //      currently this is not needed because auto_enable_created_entities
 //      cannot be false.
@@ -80,6 +91,8 @@ DataWriterImpl::DataWriterImpl()
     is_bit_(false),
     min_suspended_transaction_id_(0),
     max_suspended_transaction_id_(0),
+    async_publish_(false),
+    async_bytes_per_second_(0),
     monitor_(0),
     periodic_monitor_(0),
     liveliness_asserted_(false),
@@ -220,7 +233,8 @@ DataWriterImpl::add_association(const RepoId& yourId,
                                        ReaderInfo(reader.filterClassName,
                                                   TheServiceParticipant->publisher_content_filter() ? reader.filterExpression : "",
                                                   reader.exprParams, participant_servant_,
-                                                  reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS)));
+                                                  reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS,
+                                                  reader.readerQos)));
   }
 
   if (DCPS_debug_level > 4) {
@@ -333,12 +347,14 @@ DataWriterImpl::ReaderInfo::ReaderInfo(const char* filterClassName,
                                        const char* filter,
                                        const DDS::StringSeq& params,
                                        WeakRcHandle<DomainParticipantImpl> participant,
-                                       bool durable)
+                                       bool durable,
+                                       const DDS::DataReaderQos& reader_qos)
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
   : participant_(participant)
   , filter_class_name_(filterClassName)
   , filter_(filter)
   , expression_params_(params)
+  , field_ids_meta_(0)
   , expected_sequence_(SequenceNumber::SEQUENCENUMBER_UNKNOWN())
   , durable_(durable)
 {
@@ -346,6 +362,26 @@ DataWriterImpl::ReaderInfo::ReaderInfo(const char* filterClassName,
   if (part && *filter) {
     eval_ = part->get_filter_eval(filter);
   }
+
+  // A RELIABLE reader delivers the last filtered sample at the end of the
+  // filter period, so only BEST_EFFORT readers can be filtered here.
+  // Writer-side filtering is turned off with -DCPSPublisherContentFilter 0.
+  const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
+  if (TheServiceParticipant->publisher_content_filter()
+      && reader_qos.reliability.kind == DDS::BEST_EFFORT_RELIABILITY_QOS
+      && reader_qos.time_based_filter.minimum_separation > zero) {
+    min_separation_ =
+      duration_to_time_value(reader_qos.time_based_filter.minimum_separation);
+    min_separation_ *= TIME_BASED_FILTER_MARGIN;
+
+    if (DCPS_debug_level >= 4) {
+      ACE_DEBUG((LM_DEBUG,
+                 ACE_TEXT("(%P|%t) DataWriterImpl::ReaderInfo::ReaderInfo: ")
+                 ACE_TEXT("sending an instance at most every %u ms to a ")
+                 ACE_TEXT("BEST_EFFORT reader with a TIME_BASED_FILTER\n"),
+                 static_cast<unsigned int>(min_separation_.msec())));
+    }
+  }
 }
 #else
   : expected_sequence_(SequenceNumber::SEQUENCENUMBER_UNKNOWN())
@@ -355,9 +391,29 @@ DataWriterImpl::ReaderInfo::ReaderInfo(const char* filterClassName,
   ACE_UNUSED_ARG(filter);
   ACE_UNUSED_ARG(params);
   ACE_UNUSED_ARG(participant);
+  ACE_UNUSED_ARG(reader_qos);
 }
 #endif // OPENDDS_NO_CONTENT_FILTERED_TOPIC
 
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+bool
+DataWriterImpl::ReaderInfo::time_based_filter_out(DDS::InstanceHandle_t handle,
+                                                  const ACE_Time_Value& now)
+{
+  if (min_separation_ == ACE_Time_Value::zero) {
+    return false;
+  }
+
+  ACE_Time_Value& last_sent = last_sent_[handle];
+  if (last_sent != ACE_Time_Value::zero && now - last_sent < min_separation_) {
+    return true;
+  }
+
+  last_sent = now;
+  return false;
+}
+#endif
+
 DataWriterImpl::ReaderInfo::~ReaderInfo()
 {
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
@@ -1487,6 +1543,13 @@ DataWriterImpl::send_all_to_flush_control(ACE_Guard<ACE_Recursive_Thread_Mutex>&
 {
   DBG_ENTRY_LVL("DataWriterImpl","send_all_to_flush_control",6);
 
+  if (async_publish_) {
+    controlTracker.message_sent();
+    guard.release();
+    schedule_async_send();
+    return;
+  }
+
   SendStateDataSampleList list;
 
   ACE_UINT64 transaction_id = this->get_unsent_data(list);
@@ -1618,6 +1681,8 @@ DataWriterImpl::unregister_instance_i(DDS::InstanceHandle_t handle,
                      ret);
   }
 
+  clear_send_times(handle);
+
   DataSampleElement* element = 0;
   ret = this->data_container_->obtain_buffer_for_control(element);
 
@@ -1679,6 +1744,8 @@ DataWriterImpl::dispose_and_unregister(DDS::InstanceHandle_t handle,
                      ret);
   }
 
+  clear_send_times(handle);
+
   DataSampleElement* element = 0;
   ret = this->data_container_->obtain_buffer_for_control(element);
 
@@ -1800,6 +1867,14 @@ DataWriterImpl::write(Message_Block_Ptr data,
   if (this->coherent_) {
     ++this->coherent_samples_;
   }
+
+  if (async_publish_) {
+    // The sample waits in data_container_ for a publication thread.
+    guard.release();
+    schedule_async_send();
+    return DDS::RETCODE_OK;
+  }
+
   SendStateDataSampleList list;
 
   ACE_UINT64 transaction_id = this->get_unsent_data(list);
@@ -1859,6 +1934,20 @@ DataWriterImpl::track_sequence_number(GUIDSeq* filter_out)
 
 }
 
+void
+DataWriterImpl::clear_send_times(DDS::InstanceHandle_t handle)
+{
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+  ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
+  for (RepoIdToReaderInfoMap::iterator iter = reader_info_.begin(),
+       end = reader_info_.end(); iter != end; ++iter) {
+    iter->second.last_sent_.erase(handle);
+  }
+#else
+  ACE_UNUSED_ARG(handle);
+#endif
+}
+
 void
 DataWriterImpl::send_suspended_data()
 {
@@ -1878,6 +1967,85 @@ DataWriterImpl::send_suspended_data()
   this->available_data_list_.reset();
 }
 
+bool
+DataWriterImpl::asynchronous_publish(bool enable, size_t bytes_per_second)
+{
+  if (enable && !TheServiceParticipant->publication_thread_pool().active()) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: DataWriterImpl::")
+                      ACE_TEXT("asynchronous_publish: no publication ")
+                      ACE_TEXT("thread, publishing synchronously.\n")),
+                     false);
+  }
+
+  {
+    ACE_GUARD(ACE_Thread_Mutex, async_guard, async_send_lock_);
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, get_lock());
+    async_publish_ = enable;
+    async_bytes_per_second_ = enable ? bytes_per_second : 0;
+  }
+
+  if (!enable) {
+    // Don't leave samples written asynchronously behind.
+    send_async();
+  }
+  return true;
+}
+
+bool
+DataWriterImpl::asynchronous_publish() const
+{
+  return async_publish_;
+}
+
+void
+DataWriterImpl::schedule_async_send()
+{
+  TheServiceParticipant->publication_thread_pool().schedule(this);
+}
+
+size_t
+DataWriterImpl::send_async()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, async_guard, async_send_lock_, 0);
+  return send_async_i();
+}
+
+size_t
+DataWriterImpl::send_async_i()
+{
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, get_lock(), 0);
+
+  SendStateDataSampleList list;
+  const ACE_UINT64 transaction_id = this->get_unsent_data(list);
+  if (list.head() == 0) {
+    return 0;
+  }
+
+  size_t bytes = 0;
+  for (SendStateDataSampleList::iterator it = list.begin();
+       it != list.end(); ++it) {
+    bytes += it->get_sample()->total_length();
+  }
+
+  RcHandle<PublisherImpl> publisher = this->publisher_servant_.lock();
+  if (!publisher || publisher->is_suspended()) {
+    if (min_suspended_transaction_id_ == 0) {
+      min_suspended_transaction_id_ = transaction_id;
+    } else {
+      max_suspended_transaction_id_ = transaction_id;
+    }
+    this->available_data_list_.enqueue_tail(list);
+
+  } else {
+    guard.release();
+
+    this->send(list, transaction_id);
+  }
+
+  return bytes;
+}
+
 DDS::ReturnCode_t
 DataWriterImpl::dispose(DDS::InstanceHandle_t handle,
                         const DDS::Time_t & source_timestamp)
@@ -2298,6 +2466,13 @@ DataWriterImpl::end_coherent_changes(const GroupCoherentSamples& group_samples)
   this->coherent_samples_ = 0;
 
   guard.release();
+
+  // The samples of the set must reach the transport before its end.
+  ACE_GUARD(ACE_Thread_Mutex, async_guard, async_send_lock_);
+  if (async_publish_) {
+    send_async_i();
+  }
+
   if (this->send_control(header, move(control)) == SEND_CONTROL_ERROR) {
     ACE_ERROR((LM_ERROR,
                ACE_TEXT("(%P|%t) ERROR: DataWriterImpl::end_coherent_changes:")
@@ -2620,6 +2795,9 @@ DataWriterImpl::wait_control_pending()
 void
 DataWriterImpl::wait_pending()
 {
+  if (async_publish_) {
+    send_async();
+  }
   if (!TransportRegistry::instance()->released()) {
     data_container_->wait_pending();
   }
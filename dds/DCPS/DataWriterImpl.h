@@ -89,6 +89,7 @@ class OpenDDS_Dcps_Export DataWriterImpl
 public:
   friend class WriteDataContainer;
   friend class PublisherImpl;
+  friend class PublicationThreadPool;
 
   typedef OPENDDS_MAP_CMP(RepoId, SequenceNumber, GUID_tKeyLessThan) RepoIdToSequenceMap;
 
@@ -384,6 +385,16 @@ public:
   /// resumed and any data collected while it was suspended should now be sent.
   void send_suspended_data();
 
+  /// Hand written samples to the transport from a thread of the
+  /// Service_Participant's publication thread pool (PUBLISH_MODE
+  /// ASYNCHRONOUS) instead of the thread calling write().  A non-zero
+  /// bytes_per_second limits the rate this writer's samples are sent at.
+  /// Writes still block on RESOURCE_LIMITS while samples are unsent.
+  /// Returns false, leaving the writer synchronous, if no publication
+  /// thread could be started.
+  bool asynchronous_publish(bool enable, size_t bytes_per_second = 0);
+  bool asynchronous_publish() const;
+
   void remove_all_associations();
 
   virtual void register_for_reader(const RepoId& participant,
@@ -500,12 +511,40 @@ protected:
     OPENDDS_STRING filter_;
     DDS::StringSeq expression_params_;
     RcHandle<FilterEvaluator> eval_;
+    /// Separation the writer keeps between samples of an instance sent
+    /// to a BEST_EFFORT reader that has a TIME_BASED_FILTER, zero if
+    /// the writer doesn't filter for this reader.
+    ACE_Time_Value min_separation_;
+    typedef OPENDDS_MAP(DDS::InstanceHandle_t, ACE_Time_Value) SendTimeMap;
+    SendTimeMap last_sent_;
+    /// Ids of eval_'s fields in the writer's type, see field_ids()
+    FilterEvaluator::FieldIds field_ids_;
+    const MetaStruct* field_ids_meta_;
 #endif
     SequenceNumber expected_sequence_;
     bool durable_;
     ReaderInfo(const char* filter_class_name, const char* filter, const DDS::StringSeq& params,
-               WeakRcHandle<DomainParticipantImpl> participant, bool durable);
+               WeakRcHandle<DomainParticipantImpl> participant, bool durable,
+               const DDS::DataReaderQos& reader_qos);
     ~ReaderInfo();
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    /// Returns true if a sample of the instance written at 'now' would be
+    /// discarded by the reader's TIME_BASED_FILTER, otherwise records
+    /// 'now' as the last time the instance was sent to the reader.
+    bool time_based_filter_out(DDS::InstanceHandle_t handle,
+                               const ACE_Time_Value& now);
+
+    /// Resolves eval_'s fields against meta on first use.
+    const FilterEvaluator::FieldIds* field_ids(const MetaStruct& meta)
+    {
+      if (field_ids_meta_ != &meta) {
+        field_ids_ = eval_->getFieldIds(meta);
+        field_ids_meta_ = &meta;
+      }
+      return &field_ids_;
+    }
+#endif
   };
 
   typedef OPENDDS_MAP_CMP(RepoId, ReaderInfo, GUID_tKeyLessThan) RepoIdToReaderInfoMap;
@@ -524,6 +563,9 @@ private:
 
   void track_sequence_number(GUIDSeq* filter_out);
 
+  /// Forget the per-reader send times of an instance that is unregistered.
+  void clear_send_times(DDS::InstanceHandle_t handle);
+
   void notify_publication_lost(const DDS::InstanceHandleSeq& handles);
 
   DDS::ReturnCode_t dispose_and_unregister(DDS::InstanceHandle_t handle,
@@ -665,6 +707,22 @@ private:
   ACE_UINT64 max_suspended_transaction_id_;
   SendStateDataSampleList             available_data_list_;
 
+  /// Samples are sent by the publication thread pool.
+  bool async_publish_;
+  /// Rate limit of the asynchronous sends, 0 for none.
+  size_t async_bytes_per_second_;
+  /// Earliest time of the next rate limited asynchronous send, protected
+  /// by the lock of the PublicationThreadPool shard sending for us.
+  ACE_Time_Value async_next_send_;
+  /// Held while unsent samples are taken and handed to the transport
+  /// asynchronously, so that control messages can't overtake them.
+  ACE_Thread_Mutex async_send_lock_;
+
+  /// Send the unsent samples, returns their size in bytes.
+  size_t send_async();
+  size_t send_async_i();
+  void schedule_async_send();
+
   /// Monitor object for this entity
   Monitor* monitor_;
 
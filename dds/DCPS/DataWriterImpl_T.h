@@ -182,15 +182,22 @@ namespace OpenDDS {
       OpenDDS::DCPS::GUIDSeq_var filter_out;
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
       if (TheServiceParticipant->publisher_content_filter()) {
+        // Samples are separated by the time they were written at, which
+        // is the source timestamp given to write_w_timestamp().
+        const ACE_Time_Value now = time_to_time_value(source_timestamp);
         ACE_GUARD_RETURN(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_, DDS::RETCODE_ERROR);
         for (RepoIdToReaderInfoMap::iterator iter = reader_info_.begin(),
                end = reader_info_.end(); iter != end; ++iter) {
-          const ReaderInfo& ri = iter->second;
-          if (!ri.eval_.is_nil()) {
+          ReaderInfo& ri = iter->second;
+          if (!ri.eval_.is_nil() || ri.min_separation_ != ACE_Time_Value::zero) {
             if (!filter_out.ptr()) {
               filter_out = new OpenDDS::DCPS::GUIDSeq;
             }
-            if (!ri.eval_->eval(instance_data, ri.expression_params_)) {
+            // The send time is only recorded if the content filter passes.
+            if ((!ri.eval_.is_nil()
+                 && !ri.eval_->eval(instance_data, ri.expression_params_,
+                                    ri.field_ids(getMetaStruct<MessageType>())))
+                || ri.time_based_filter_out(handle, now)) {
               push_back(filter_out.inout(), iter->first);
             }
           }
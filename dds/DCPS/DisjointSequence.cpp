@@ -330,6 +330,26 @@ DisjointSequence::contains(SequenceNumber value) const
   return iter != sequences_.end() && iter->first <= value;
 }
 
+bool
+DisjointSequence::erase(SequenceNumber value)
+{
+  RangeSet::iterator iter =
+    sequences_.lower_bound(SequenceRange(0 /*ignored*/, value));
+  if (iter == sequences_.end() || value < iter->first) {
+    return false;
+  }
+
+  const SequenceRange range = *iter;
+  sequences_.erase(iter);
+  if (range.first < value) {
+    sequences_.insert(SequenceRange(range.first, value.previous()));
+  }
+  if (value < range.second) {
+    sequences_.insert(SequenceRange(++value, range.second));
+  }
+  return true;
+}
+
 void
 DisjointSequence::validate(const SequenceRange& range)
 {
@@ -83,6 +83,10 @@ public:
               CORBA::ULong num_bits,
               const CORBA::Long bits[]);
 
+  /// Remove value from the set, splitting the range that contains it.
+  /// Returns false if the set didn't contain value.
+  bool erase(SequenceNumber value);
+
   /// Inverse of insert(value, num_bits, bits).  Populates array of
   /// bitmap[length] with the bitmap of ranges above the cumulative_ack() value.
   /// Sets the number of significant (used) bits in num_bits.  The 'base' of the
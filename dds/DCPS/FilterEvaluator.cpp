@@ -67,8 +67,12 @@ FilterEvaluator::FilterEvaluator(const char* filter, bool allowOrderBy)
 
 FilterEvaluator::FilterEvaluator(const AstNodeWrapper& yardNode)
   : extended_grammar_(false)
-  , filter_root_(walkAst(yardNode))
+  , filter_root_(0)
+  , number_parameters_(0)
 {
+  // walkAst registers fields in field_names_, so it can't run until all
+  // members are constructed
+  filter_root_ = walkAst(yardNode);
 }
 
 class FilterEvaluator::EvalNode {
@@ -115,15 +119,19 @@ public:
 };
 
 Value
-FilterEvaluator::DeserializedForEval::lookup(const char* field) const
+FilterEvaluator::DeserializedForEval::lookup(size_t index,
+                                             const char* field) const
 {
-  return meta_.getValue(deserialized_, field);
+  const int id = fieldId(index);
+  return id < 0 ? meta_.getValue(deserialized_, field)
+    : meta_.getValueById(deserialized_, id);
 }
 
 Value
-FilterEvaluator::SerializedForEval::lookup(const char* field) const
+FilterEvaluator::SerializedForEval::lookup(size_t index,
+                                           const char* field) const
 {
-  const OPENDDS_MAP(OPENDDS_STRING, Value)::const_iterator iter = cache_.find(field);
+  const OPENDDS_MAP(size_t, Value)::const_iterator iter = cache_.find(index);
   if (iter != cache_.end()) {
     return iter->second;
   }
@@ -133,8 +141,10 @@ FilterEvaluator::SerializedForEval::lookup(const char* field) const
   if (cdr_) {
     ser.skip(4); // CDR encapsulation header
   }
-  const Value v = meta_.getValue(ser, field);
-  cache_.insert(std::make_pair(OPENDDS_STRING(field), v));
+  const int id = fieldId(index);
+  const Value v = id < 0 ? meta_.getValue(ser, field)
+    : meta_.getValueById(ser, id);
+  cache_.insert(std::make_pair(index, v));
   return v;
 }
 
@@ -161,18 +171,39 @@ bool FilterEvaluator::has_non_key_fields(const MetaStruct& meta) const
   return false;
 }
 
+FilterEvaluator::FieldIds
+FilterEvaluator::getFieldIds(const MetaStruct& meta) const
+{
+  FieldIds ids;
+  ids.reserve(field_names_.size());
+  for (
+    OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator i = field_names_.begin();
+    i != field_names_.end(); ++i
+  ) {
+    ids.push_back(meta.getFieldId(i->c_str()));
+  }
+  return ids;
+}
+
 namespace {
 
   class FieldLookup : public FilterEvaluator::Operand {
   public:
-    explicit FieldLookup(AstNode* fnNode)
+    FieldLookup(AstNode* fnNode, OPENDDS_VECTOR(OPENDDS_STRING)& fieldNames)
       : fieldName_(toString(fnNode))
+      , index_(std::find(fieldNames.begin(), fieldNames.end(), fieldName_)
+               - fieldNames.begin())
     {
+      // A field referenced more than once shares its index, so that its
+      // value is only looked up once per sample.
+      if (index_ == fieldNames.size()) {
+        fieldNames.push_back(fieldName_);
+      }
     }
 
     Value eval(FilterEvaluator::DataForEval& data)
     {
-      return data.lookup(fieldName_.c_str());
+      return data.lookup(index_, fieldName_.c_str());
     }
 
     bool has_non_key_fields(const MetaStruct& meta) const
@@ -181,6 +212,7 @@ namespace {
     }
 
     OPENDDS_STRING fieldName_;
+    size_t index_;
   };
 
   class LiteralInt : public FilterEvaluator::Operand {
@@ -511,7 +543,7 @@ FilterEvaluator::Operand*
 FilterEvaluator::walkOperand(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<FieldName>()) {
-    return new FieldLookup(node);
+    return new FieldLookup(node, field_names_);
   } else if (node->TypeMatches<IntVal>()) {
     return new LiteralInt(node);
   } else if (node->TypeMatches<CharVal>()) {
@@ -973,6 +1005,24 @@ MetaStruct::~MetaStruct()
 {
 }
 
+int
+MetaStruct::getFieldId(const char*) const
+{
+  return -1;
+}
+
+Value
+MetaStruct::getValueById(const void*, int) const
+{
+  throw std::runtime_error("MetaStruct::getValueById not supported");
+}
+
+Value
+MetaStruct::getValueById(Serializer&, int) const
+{
+  throw std::runtime_error("MetaStruct::getValueById not supported");
+}
+
 }
 }
 
@@ -103,13 +103,25 @@ public:
 
   bool has_non_key_fields(const MetaStruct& meta) const;
 
+  /// Field ids (see MetaStruct::getFieldId) of the fields referenced by the
+  /// filter, indexed in the order the filter references them.
+  typedef OPENDDS_VECTOR(int) FieldIds;
+
+  /**
+   * Resolves the fields referenced by the filter against the type described
+   * by meta.  Callers that evaluate many samples of one type can pass the
+   * result to eval() so that fields are not looked up by name per sample.
+   */
+  FieldIds getFieldIds(const MetaStruct& meta) const;
+
   /**
    * Returns true if the unserialized sample matches the filter.
    */
   template<typename T>
-  bool eval(const T& sample, const DDS::StringSeq& params) const
+  bool eval(const T& sample, const DDS::StringSeq& params,
+            const FieldIds* ids = 0) const
   {
-    DeserializedForEval data(&sample, getMetaStruct<T>(), params);
+    DeserializedForEval data(&sample, getMetaStruct<T>(), params, ids);
     return eval_i(data);
   }
 
@@ -118,9 +130,9 @@ public:
    */
   bool eval(ACE_Message_Block* serializedSample, bool swap_bytes,
             bool cdr_encap, const MetaStruct& meta,
-            const DDS::StringSeq& params) const
+            const DDS::StringSeq& params, const FieldIds* ids = 0) const
   {
-    SerializedForEval data(serializedSample, meta, params,
+    SerializedForEval data(serializedSample, meta, params, ids,
                            swap_bytes, cdr_encap);
     return eval_i(data);
   }
@@ -129,12 +141,19 @@ public:
   class Operand;
 
   struct OpenDDS_Dcps_Export DataForEval {
-    DataForEval(const MetaStruct& meta, const DDS::StringSeq& params)
-      : meta_(meta), params_(params) {}
+    DataForEval(const MetaStruct& meta, const DDS::StringSeq& params,
+                const FieldIds* ids = 0)
+      : meta_(meta), params_(params), ids_(ids) {}
     virtual ~DataForEval();
-    virtual Value lookup(const char* field) const = 0;
+    /// index is the position of the field in the filter's field list
+    virtual Value lookup(size_t index, const char* field) const = 0;
+    int fieldId(size_t index) const
+    {
+      return (ids_ && index < ids_->size()) ? (*ids_)[index] : -1;
+    }
     const MetaStruct& meta_;
     const DDS::StringSeq& params_;
+    const FieldIds* ids_;
   private:
     DataForEval(const DataForEval&);
     DataForEval& operator=(const DataForEval&);
@@ -149,21 +168,22 @@ private:
 
   struct OpenDDS_Dcps_Export DeserializedForEval : DataForEval {
     DeserializedForEval(const void* data, const MetaStruct& meta,
-                        const DDS::StringSeq& params)
-      : DataForEval(meta, params), deserialized_(data) {}
+                        const DDS::StringSeq& params, const FieldIds* ids)
+      : DataForEval(meta, params, ids), deserialized_(data) {}
     virtual ~DeserializedForEval();
-    Value lookup(const char* field) const;
+    Value lookup(size_t index, const char* field) const;
     const void* const deserialized_;
   };
 
   struct SerializedForEval : DataForEval {
     SerializedForEval(ACE_Message_Block* data, const MetaStruct& meta,
-                      const DDS::StringSeq& params, bool swap, bool cdr)
-      : DataForEval(meta, params), serialized_(data), swap_(swap), cdr_(cdr) {}
-    Value lookup(const char* field) const;
+                      const DDS::StringSeq& params, const FieldIds* ids,
+                      bool swap, bool cdr)
+      : DataForEval(meta, params, ids), serialized_(data), swap_(swap), cdr_(cdr) {}
+    Value lookup(size_t index, const char* field) const;
     ACE_Message_Block* serialized_;
     bool swap_, cdr_;
-    mutable OPENDDS_MAP(OPENDDS_STRING, Value) cache_;
+    mutable OPENDDS_MAP(size_t, Value) cache_;
   };
 
   bool eval_i(DataForEval& data) const;
@@ -174,6 +194,8 @@ private:
   /// Number of parameter used in the filter, this should
   /// match the number of values passed when evaluating the filter
   size_t number_parameters_;
+  /// Fields referenced by the filter, see FieldIds
+  OPENDDS_VECTOR(OPENDDS_STRING) field_names_;
 
 };
 
@@ -195,6 +217,13 @@ public:
 
   virtual bool isDcpsKey(const char* field) const = 0;
 
+  /// Returns an id for fieldSpec that can be passed to the *ById() functions
+  /// below, or -1 if the field can only be accessed by name.
+  virtual int getFieldId(const char* fieldSpec) const;
+
+  virtual Value getValueById(const void* stru, int fieldId) const;
+  virtual Value getValueById(Serializer& ser, int fieldId) const;
+
 #ifndef OPENDDS_NO_MULTI_TOPIC
   virtual size_t numDcpsKeys() const = 0;
 
@@ -11,12 +11,23 @@
 #include "dds/DCPS/DataReaderImpl.h"
 #include "dds/DCPS/QueryConditionImpl.h"
 
+#include <algorithm>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  bool source_timestamp_less(const RakeData& lhs, const RakeData& rhs)
+  {
+    return lhs.rde_->source_timestamp_ < rhs.rde_->source_timestamp_;
+  }
+}
+
 GroupRakeData::GroupRakeData()
+  : sorted_(true)
+  , current_sample_(0)
 {
 }
 
@@ -32,9 +43,10 @@ bool GroupRakeData::insert_sample(ReceivedDataElement* sample,
   }
 
   RakeData rd = {sample, instance, index_in_instance};
-  this->sorted_.insert(rd);
+  this->samples_.push_back(rd);
+  this->sorted_ = false;
 
-  this->current_sample_ = this->sorted_.begin();
+  this->current_sample_ = 0;
   return true;
 }
 
@@ -44,10 +56,11 @@ GroupRakeData::get_datareaders(DDS::DataReaderSeq & readers)
 {
   ACE_UNUSED_ARG(readers);
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
-  readers.length(static_cast<CORBA::ULong>(this->sorted_.size()));
+  this->sort();
+  readers.length(static_cast<CORBA::ULong>(this->samples_.size()));
   CORBA::ULong i = 0;
-  SortedSet::iterator itEnd = this->sorted_.end();
-  for (SortedSet::iterator it = this->sorted_.begin(); it != itEnd; ++it) {
+  SampleList::iterator itEnd = this->samples_.end();
+  for (SampleList::iterator it = this->samples_.begin(); it != itEnd; ++it) {
     readers[i++] =
       DDS::DataReader::_duplicate(it->si_->instance_state_.data_reader());
   }
@@ -58,16 +71,31 @@ GroupRakeData::get_datareaders(DDS::DataReaderSeq & readers)
 void
 GroupRakeData::reset()
 {
-  this->sorted_.clear();
+  this->samples_.clear();
+  this->sorted_ = true;
+  this->current_sample_ = 0;
 }
 
 
 RakeData
 GroupRakeData::get_data()
 {
-  RakeData data = *this->current_sample_;
-  ++this->current_sample_;
-  return data;
+  this->sort();
+  return this->samples_[this->current_sample_++];
+}
+
+
+void
+GroupRakeData::sort()
+{
+  if (!this->sorted_) {
+    // Samples from each reader are mostly inserted in order already, a
+    // stable sort keeps equal timestamps in insertion order like the
+    // multiset used to.
+    std::stable_sort(this->samples_.begin(), this->samples_.end(),
+                     source_timestamp_less);
+    this->sorted_ = true;
+  }
 }
 
 } // namespace DCPS
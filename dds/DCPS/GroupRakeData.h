@@ -18,7 +18,6 @@
 #include "dds/DdsDcpsSubscriptionC.h"
 #include "dds/DdsDcpsInfrastructureC.h"
 #include "RakeData.h"
-#include "Comparator_T.h"
 
 #include "PoolAllocator.h"
 
@@ -49,35 +48,21 @@ public:
   RakeData get_data ();
 
 private:
-
-
   GroupRakeData(const GroupRakeData&); // no copy construction
   GroupRakeData& operator=(const GroupRakeData&); // no assignment
 
-  class SortedSetCmp {
-  public:
-    bool operator()(const RakeData& lhs, const RakeData& rhs) const {
-      if (!cmp_.in()) {
-        // The following assumes that if no comparator is set
-        // then BY_SOURCE_TIMESTAMP_DESTINATIONORDER_QOS is used.
-        return lhs.rde_->source_timestamp_ < rhs.rde_->source_timestamp_;
-      }
-
-      return false;
-    }
-    SortedSetCmp(){}
-    explicit SortedSetCmp(ComparatorBase::Ptr cmp) : cmp_(cmp){}
-
-  private:
-    ComparatorBase::Ptr cmp_;
-  };
+  /// Order the samples by source timestamp (the only ordering supported
+  /// for GROUP ordered_access) the first time they are accessed after an
+  /// insert_sample().
+  void sort();
 
-  typedef OPENDDS_MULTISET_CMP(RakeData, SortedSetCmp) SortedSet;
+  typedef OPENDDS_VECTOR(RakeData) SampleList;
 
   // Contains data for QueryCondition/Ordered access
-  SortedSet sorted_;
+  SampleList samples_;
+  bool sorted_;
 
-  SortedSet::iterator current_sample_;
+  size_t current_sample_;
 };
 
 } // namespace DCPS
@@ -35,7 +35,11 @@ OpenDDS::DCPS::InstanceState::InstanceState(DataReaderImpl* reader,
     release_timer_id_(-1),
     reader_(reader),
     handle_(handle),
+#ifdef ACE_HAS_CPP11
+    owner_version_(0),
+#endif
     owner_(GUID_UNKNOWN),
+    owner_strength_(0),
 #ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
     exclusive_(reader->qos_.ownership.kind == ::DDS::EXCLUSIVE_OWNERSHIP_QOS),
 #endif
@@ -284,15 +288,40 @@ OpenDDS::DCPS::InstanceState::release()
 }
 
 void
-OpenDDS::DCPS::InstanceState::set_owner (const PublicationId& owner)
+OpenDDS::DCPS::InstanceState::set_owner (const PublicationId& owner,
+                                         CORBA::Long strength)
 {
-  this->owner_ = owner;
+  this->write_owner(owner, strength);
 }
 
-OpenDDS::DCPS::PublicationId&
+OpenDDS::DCPS::PublicationId
 OpenDDS::DCPS::InstanceState::get_owner ()
 {
-  return this->owner_;
+  PublicationId owner;
+  CORBA::Long strength;
+  while (!this->read_owner(owner, strength)) {
+    // a writer is between the two updates of owner_version_
+  }
+  return owner;
+}
+
+void
+OpenDDS::DCPS::InstanceState::write_owner (const PublicationId& owner,
+                                           CORBA::Long strength)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, this->owner_lock_);
+#ifdef ACE_HAS_CPP11
+  const unsigned long version =
+    this->owner_version_.load(std::memory_order_relaxed);
+  this->owner_version_.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->owner_ = owner;
+  this->owner_strength_ = strength;
+  this->owner_version_.store(version + 2, std::memory_order_release);
+#else
+  this->owner_ = owner;
+  this->owner_strength_ = strength;
+#endif
 }
 
 bool
@@ -318,7 +347,7 @@ OpenDDS::DCPS::InstanceState::registered (bool flag)
 void
 OpenDDS::DCPS::InstanceState::reset_ownership (::DDS::InstanceHandle_t instance)
 {
-  this->owner_ = GUID_UNKNOWN;
+  this->write_owner(GUID_UNKNOWN, 0);
   this->registered_ = false;
 
   this->reader_->reset_ownership(instance);
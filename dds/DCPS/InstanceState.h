@@ -10,12 +10,17 @@
 
 #include "dcps_export.h"
 #include "ace/Time_Value.h"
+#include "ace/Thread_Mutex.h"
 #include "dds/DdsDcpsInfrastructureC.h"
 #include "dds/DCPS/Definitions.h"
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/RepoIdTypes.h"
 
+#ifdef ACE_HAS_CPP11
+#  include <atomic>
+#endif
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -118,8 +123,16 @@ public:
   virtual int handle_timeout(const ACE_Time_Value& current_time,
                              const void* arg);
 
-  void set_owner (const PublicationId& owner);
-  PublicationId& get_owner ();
+  void set_owner (const PublicationId& owner, CORBA::Long strength);
+  PublicationId get_owner ();
+
+  /// Lock-free check of the ownership slot: true when the provided
+  /// writer is the current owner and its strength matches the strength
+  /// the owner was elected with.  Any mismatch, or a slot being updated,
+  /// means the ownership must be re-evaluated through the
+  /// OwnershipManager.
+  bool is_owner (const PublicationId& pub, CORBA::Long strength) const;
+
   bool is_exclusive () const;
   bool registered();
   void registered (bool flag);
@@ -206,7 +219,26 @@ private:
   DDS::InstanceHandle_t handle_;
 
   RepoIdSet writers_;
+
+  /// Write owner_ and owner_strength_ for set_owner() and reset_ownership().
+  void write_owner(const PublicationId& owner, CORBA::Long strength);
+
+  /// Copy owner_ and owner_strength_, false if they were being written
+  /// meanwhile and the copy may be torn.
+  bool read_owner(PublicationId& owner, CORBA::Long& strength) const;
+
+  /// Serializes the writers of owner_ and owner_strength_, which are the
+  /// OwnershipManagers of any reader sharing the instance handle.
+  /// Without C++11 atomics the readers take it too.
+  mutable ACE_Thread_Mutex owner_lock_;
+#ifdef ACE_HAS_CPP11
+  /// Sequence lock of owner_ and owner_strength_: odd while they are
+  /// written, a reader that sees it change retries or gives up.
+  std::atomic<unsigned long> owner_version_;
+#endif
   PublicationId owner_;
+  /// Strength of owner_ at the time it was elected or last confirmed.
+  CORBA::Long owner_strength_;
   bool exclusive_;
   /// registered with participant so it can be called back as
   /// the owner is updated.
@@ -160,6 +160,40 @@ OpenDDS::DCPS::InstanceState::is_last (const PublicationId& pub)
   return (this->writers_.size () == 1) && *(this->writers_.begin ()) == pub;
 }
 
+ACE_INLINE
+bool
+OpenDDS::DCPS::InstanceState::is_owner (const PublicationId& pub,
+                                        CORBA::Long strength) const
+{
+  PublicationId owner;
+  CORBA::Long owner_strength;
+  return this->read_owner(owner, owner_strength)
+    && owner_strength == strength && owner == pub;
+}
+
+ACE_INLINE
+bool
+OpenDDS::DCPS::InstanceState::read_owner (PublicationId& owner,
+                                          CORBA::Long& strength) const
+{
+#ifdef ACE_HAS_CPP11
+  const unsigned long version =
+    this->owner_version_.load(std::memory_order_acquire);
+  if (version & 1) {
+    return false;
+  }
+  owner = this->owner_;
+  strength = this->owner_strength_;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return this->owner_version_.load(std::memory_order_relaxed) == version;
+#else
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, this->owner_lock_, false);
+  owner = this->owner_;
+  strength = this->owner_strength_;
+  return true;
+#endif
+}
+
 ACE_INLINE
 bool
 OpenDDS::DCPS::InstanceState::no_writer () const
@@ -220,7 +220,7 @@ OwnershipManager::remove_writer(const DDS::InstanceHandle_t& instance_handle,
                                 const PublicationId& pub_id)
 {
   if (infos.owner_.pub_id_ == pub_id) {
-    remove_owner(instance_handle, infos, false);
+    remove_owner(instance_handle, infos);
     return true;
 
   } else {
@@ -232,20 +232,14 @@ OwnershipManager::remove_writer(const DDS::InstanceHandle_t& instance_handle,
 
 void
 OwnershipManager::remove_owner(const DDS::InstanceHandle_t& instance_handle,
-                               OwnershipWriterInfos& infos,
-                               bool sort)
+                               OwnershipWriterInfos& infos)
 {
-  //change owner
+  //change owner, the strongest candidate is at the front.
   PublicationId new_owner(GUID_UNKNOWN);
   if (infos.candidates_.empty()) {
     infos.owner_ = WriterInfo();
 
   } else {
-    if (sort) {
-      std::sort(infos.candidates_.begin(), infos.candidates_.end(),
-                Util::DescendingOwnershipStrengthSort);
-    }
-
     const WriterInfos::iterator begin = infos.candidates_.begin();
     infos.owner_ = *begin;
     infos.candidates_.erase(begin);
@@ -265,7 +259,7 @@ OwnershipManager::remove_candidate(OwnershipWriterInfos& infos,
 
     WriterInfos::iterator found_candidate = the_end;
     // Supplied writer is not an owner, check if it exists in candidate list.
-    // If not, add it to the candidate list and sort the list.
+    // Erasing keeps the remaining candidates ordered.
     for (WriterInfos::iterator iter = infos.candidates_.begin();
          iter != the_end; ++iter) {
       if (iter->pub_id_ == pub_id) {
@@ -295,6 +289,10 @@ OwnershipManager::select_owner(const DDS::InstanceHandle_t& instance_handle,
     if (!instance_state->registered()) {
       infos.instance_states_.push_back(instance_state);
       instance_state->registered(true);
+      // A newly registered instance state needs the current owner in
+      // its slot even if the owner does not change below.
+      instance_state->set_owner(infos.owner_.pub_id_,
+                                infos.owner_.ownership_strength_);
     }
 
     // No owner at some point.
@@ -306,60 +304,49 @@ OwnershipManager::select_owner(const DDS::InstanceHandle_t& instance_handle,
     } else if (infos.owner_.pub_id_ == pub_id) { // is current owner
       //still owner but strength changed to be bigger..
       if (infos.owner_.ownership_strength_ <= ownership_strength) {
-        infos.owner_.ownership_strength_ = ownership_strength;
+        if (infos.owner_.ownership_strength_ != ownership_strength) {
+          infos.owner_.ownership_strength_ = ownership_strength;
+          // Refresh the strength held in the instance ownership slots.
+          broadcast_new_owner(instance_handle, infos, pub_id);
+        }
         return true;
 
       } else { //update strength and reevaluate owner which broadcast new owner.
-        infos.candidates_.push_back(WriterInfo(pub_id, ownership_strength));
-        remove_owner(instance_handle, infos, true);
+        insert_candidate(infos, WriterInfo(pub_id, ownership_strength));
+        remove_owner(instance_handle, infos);
         return infos.owner_.pub_id_ == pub_id;
       }
 
     } else { // not current owner, reevaluate the owner
-      bool replace_owner = false;
-      // Add current owner to candidate list for owner reevaluation
-      // if provided pub has strength greater than current owner.
-      if (ownership_strength > infos.owner_.ownership_strength_) {
-        infos.candidates_.push_back(infos.owner_);
-        replace_owner = true;
-      }
-
-      bool found = false;
-      bool sort = true;
-
-      // check if it already existed in candidate list. If not,
-      // add it to the candidate list, otherwise update strength
-      // if strength was changed.
+      // Check if it already existed in candidate list. If so and the
+      // strength is unchanged, the ownership can not change.
       const WriterInfos::iterator the_end = infos.candidates_.end();
-
+      WriterInfos::iterator found = the_end;
       for (WriterInfos::iterator iter = infos.candidates_.begin();
            iter != the_end; ++iter) {
-
         if (iter->pub_id_ == pub_id) {
-          if (iter->ownership_strength_ != ownership_strength) {
-            iter->ownership_strength_ = ownership_strength;
-          } else {
-            sort = false;
-          }
-          found = true;
+          found = iter;
           break;
         }
       }
 
-      if (!found) {
-        infos.candidates_.push_back(WriterInfo(pub_id, ownership_strength));
+      if (found != the_end) {
+        if (found->ownership_strength_ == ownership_strength
+            && ownership_strength <= infos.owner_.ownership_strength_) {
+          return false;
+        }
+        infos.candidates_.erase(found);
       }
 
-      if (sort) {
-        std::sort(infos.candidates_.begin(), infos.candidates_.end(),
-                  Util::DescendingOwnershipStrengthSort);
-      }
+      // Candidates are kept ordered by descending strength, so an
+      // ordered insertion replaces re-sorting the whole list.
+      insert_candidate(infos, WriterInfo(pub_id, ownership_strength));
 
-      if (replace_owner) {
-        // Owner was already moved to candidate list and the list was sorted
-        // already so pick owner from sorted list and replace current
-        // owner.
-        remove_owner(instance_handle, infos, false);
+      // Add current owner to candidate list for owner reevaluation
+      // if provided pub has strength greater than current owner.
+      if (ownership_strength > infos.owner_.ownership_strength_) {
+        insert_candidate(infos, infos.owner_);
+        remove_owner(instance_handle, infos);
       }
 
       return infos.owner_.pub_id_ == pub_id;
@@ -380,6 +367,15 @@ OwnershipManager::select_owner(const DDS::InstanceHandle_t& instance_handle,
   return false;
 }
 
+void
+OwnershipManager::insert_candidate(OwnershipWriterInfos& infos,
+                                   const WriterInfo& candidate)
+{
+  infos.candidates_.insert(
+    std::upper_bound(infos.candidates_.begin(), infos.candidates_.end(),
+                     candidate, Util::DescendingOwnershipStrengthSort),
+    candidate);
+}
 
 void
 OwnershipManager::broadcast_new_owner(const DDS::InstanceHandle_t& instance_handle,
@@ -403,7 +399,7 @@ OwnershipManager::broadcast_new_owner(const DDS::InstanceHandle_t& instance_hand
   const InstanceStateVec::iterator the_end = infos.instance_states_.end();
   for (InstanceStateVec::iterator iter = infos.instance_states_.begin();
        iter != the_end; ++iter) {
-    (*iter)->set_owner(owner);
+    (*iter)->set_owner(owner, infos.owner_.ownership_strength_);
   }
 }
 
@@ -416,7 +412,7 @@ OwnershipManager::remove_owner(const DDS::InstanceHandle_t& instance_handle)
     instance_ownership_infos_.find(instance_handle);
 
   if (iter != instance_ownership_infos_.end()) {
-    remove_owner(instance_handle, iter->second, false);
+    remove_owner(instance_handle, iter->second);
   }
 }
 
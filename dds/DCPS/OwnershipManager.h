@@ -69,6 +69,7 @@ public:
 
   struct OwnershipWriterInfos {
     WriterInfo owner_;
+    /// Ordered by descending ownership strength.
     WriterInfos candidates_;
     InstanceStateVec instance_states_;
   };
@@ -135,6 +136,11 @@ public:
 
   /**
   * Determine if the provided publication can be the owner.
+  * The outcome is also published to the ownership slot of every
+  * InstanceState registered for the instance, which lets the reader
+  * accept samples from the owner without taking instance_lock_ or any
+  * other lock (see InstanceState::is_owner).  This only needs to be
+  * called when the slot does not match the writer.
   */
   bool select_owner(const DDS::InstanceHandle_t& instance_handle,
                     const PublicationId& pub_id,
@@ -161,8 +167,11 @@ private:
                      const PublicationId& pub_id);
 
   void remove_owner(const DDS::InstanceHandle_t& instance_handle,
-                    OwnershipWriterInfos& infos,
-                    bool sort);
+                    OwnershipWriterInfos& infos);
+
+  /// Insert into candidates_ keeping descending strength order.
+  void insert_candidate(OwnershipWriterInfos& infos,
+                        const WriterInfo& candidate);
 
   void remove_candidate(OwnershipWriterInfos& infos,
                         const PublicationId& pub_id);
@@ -0,0 +1,159 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "PublicationThreadPool.h"
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+PublicationThreadPool::PublicationThreadPool(size_t n_threads)
+{
+  if (n_threads == 0) {
+    const long n_cpus = ACE_OS::num_processors();
+    n_threads = n_cpus > 0 ? n_cpus : 1;
+  }
+
+  for (size_t i = 0; i < n_threads; ++i) {
+    Shard* const shard = new Shard;
+    if (shard->activate(THR_NEW_LWP | THR_JOINABLE, 1) == -1) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: PublicationThreadPool::")
+                 ACE_TEXT("PublicationThreadPool: activate failed.\n")));
+      delete shard;
+      break;
+    }
+    shards_.push_back(shard);
+  }
+}
+
+PublicationThreadPool::~PublicationThreadPool()
+{
+  shutdown();
+}
+
+void
+PublicationThreadPool::schedule(DataWriterImpl* writer)
+{
+  // Never send from the caller, it may hold the writer's lock which
+  // must not be taken before async_send_lock_.
+  if (shards_.empty()) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) ERROR: PublicationThreadPool::schedule: ")
+               ACE_TEXT("no publication thread, samples stay queued.\n")));
+    return;
+  }
+  shard_for(writer).schedule(writer);
+}
+
+bool
+PublicationThreadPool::active() const
+{
+  return !shards_.empty();
+}
+
+void
+PublicationThreadPool::shutdown()
+{
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    shards_[i]->stop();
+  }
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    shards_[i]->wait();
+    delete shards_[i];
+  }
+  shards_.clear();
+}
+
+PublicationThreadPool::Shard&
+PublicationThreadPool::shard_for(DataWriterImpl* writer)
+{
+  const size_t key = reinterpret_cast<size_t>(writer) / sizeof(void*);
+  return *shards_[key % shards_.size()];
+}
+
+PublicationThreadPool::Shard::Shard()
+  : condition_(lock_)
+  , stopped_(false)
+{
+}
+
+void
+PublicationThreadPool::Shard::schedule(DataWriterImpl* writer)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  if (stopped_ || !queued_.insert(writer).second) {
+    return;
+  }
+
+  const ACE_Time_Value when =
+    std::max(ACE_OS::gettimeofday(), writer->async_next_send_);
+  const bool earliest = queue_.empty() || when < queue_.begin()->first;
+  queue_.insert(std::make_pair(when, rchandle_from(writer)));
+  if (earliest) {
+    condition_.signal();
+  }
+}
+
+void
+PublicationThreadPool::Shard::stop()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  stopped_ = true;
+  queue_.clear();
+  queued_.clear();
+  condition_.signal();
+}
+
+int
+PublicationThreadPool::Shard::svc()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, -1);
+  while (!stopped_) {
+    if (queue_.empty()) {
+      condition_.wait();
+      continue;
+    }
+
+    ACE_Time_Value due = queue_.begin()->first;
+    if (ACE_OS::gettimeofday() < due) {
+      // the earliest DataWriter is rate limited
+      condition_.wait(&due);
+      continue;
+    }
+
+    const DataWriterImpl_rch writer = queue_.begin()->second;
+    queue_.erase(queue_.begin());
+    queued_.erase(writer.in());
+
+    // Samples written from now on need another pass.
+    guard.release();
+    const size_t bytes = writer->send_async();
+    guard.acquire();
+
+    const size_t rate = writer->async_bytes_per_second_;
+    if (rate && bytes) {
+      const ACE_UINT64 usec = ACE_UINT64(bytes) * 1000000 / rate;
+      const ACE_Time_Value cost(static_cast<time_t>(usec / 1000000),
+                                static_cast<suseconds_t>(usec % 1000000));
+      writer->async_next_send_ = ACE_OS::gettimeofday() + cost;
+    }
+  }
+  return 0;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
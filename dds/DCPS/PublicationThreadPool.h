@@ -0,0 +1,90 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_PUBLICATIONTHREADPOOL_H
+#define OPENDDS_DCPS_PUBLICATIONTHREADPOOL_H
+
+#include /**/ "ace/pre.h"
+#include "dcps_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "DataWriterImpl.h"
+#include "PoolAllocator.h"
+
+#include "ace/Task.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// Threads that hand the samples of asynchronously publishing DataWriters
+/// (see DataWriterImpl::asynchronous_publish()) to the transport, so that
+/// write() returns without waiting for the send.
+///
+/// The pool is split in shards of one thread each, a DataWriter is always
+/// handled by the same shard which preserves the order of its samples.
+/// The samples themselves stay queued in the DataWriter's
+/// WriteDataContainer, the shard only queues the DataWriters that have
+/// unsent samples, at most once each.  A DataWriter with a rate limit is
+/// not handled again before its previous send is paid for.
+class OpenDDS_Dcps_Export PublicationThreadPool {
+public:
+  /// n_threads of 0 uses one thread per processor.
+  explicit PublicationThreadPool(size_t n_threads);
+  ~PublicationThreadPool();
+
+  /// Have a pool thread send the unsent samples of writer.
+  void schedule(DataWriterImpl* writer);
+
+  /// True if at least one thread was started.
+  bool active() const;
+
+  /// Stop the threads, DataWriters still queued are not sent.
+  void shutdown();
+
+private:
+  class Shard : public ACE_Task_Base {
+  public:
+    Shard();
+
+    int svc();
+    void schedule(DataWriterImpl* writer);
+    void stop();
+
+  private:
+    ACE_Thread_Mutex lock_;
+    ACE_Condition_Thread_Mutex condition_;
+
+    /// DataWriters waiting to be sent, by the time they may be sent at.
+    typedef OPENDDS_MULTIMAP(ACE_Time_Value, DataWriterImpl_rch) Queue;
+    Queue queue_;
+    OPENDDS_SET(DataWriterImpl*) queued_;
+    bool stopped_;
+  };
+
+  Shard& shard_for(DataWriterImpl* writer);
+
+  OPENDDS_VECTOR(Shard*) shards_;
+
+  PublicationThreadPool(const PublicationThreadPool&);
+  PublicationThreadPool& operator=(const PublicationThreadPool&);
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* OPENDDS_DCPS_PUBLICATIONTHREADPOOL_H */
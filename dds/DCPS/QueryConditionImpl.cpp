@@ -23,6 +23,7 @@ QueryConditionImpl::QueryConditionImpl(
   : ReadConditionImpl(dr, sample_states, view_states, instance_states)
   , query_expression_(query_expression)
   , evaluator_(query_expression, true)
+  , field_ids_meta_(0)
 {
   if (DCPS_debug_level > 5) {
     ACE_DEBUG((LM_DEBUG,
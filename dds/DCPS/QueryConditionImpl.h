@@ -73,14 +73,27 @@ public:
       }
       return false;
     }
-    return evaluator_.eval(s, query_parameters_);
+    return evaluator_.eval(s, query_parameters_, &field_ids(meta));
   }
 
 private:
+  /// Caller must hold lock_
+  const FilterEvaluator::FieldIds& field_ids(const MetaStruct& meta) const
+  {
+    if (field_ids_meta_ != &meta) {
+      field_ids_ = evaluator_.getFieldIds(meta);
+      field_ids_meta_ = &meta;
+    }
+    return field_ids_;
+  }
+
   CORBA::String_var query_expression_;
   DDS::StringSeq query_parameters_;
   FilterEvaluator evaluator_;
-  /// Concurrent access to query_parameters_
+  /// Ids of the query's fields in the reader's type
+  mutable FilterEvaluator::FieldIds field_ids_;
+  mutable const MetaStruct* field_ids_meta_;
+  /// Concurrent access to query_parameters_ and field_ids_
   mutable ACE_Recursive_Thread_Mutex lock_;
 };
 
@@ -85,6 +85,8 @@ bool RakeResults<SampleSeq>::insert_sample(ReceivedDataElement* sample,
                                            SubscriptionInstance_rch instance,
                                            size_t index_in_instance)
 {
+  sample->deserialize();
+
 #ifndef OPENDDS_NO_QUERY_CONDITION
 
   if (do_filter_) {
@@ -12,11 +12,58 @@
 #include "dds/DCPS/PoolAllocationBase.h"
 #include "RcHandle_T.h"
 
+#ifdef ACE_HAS_CPP11
+#  include <atomic>
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+  /// Reference count shared by RcObject and WeakObject.
+  /// Increments don't need to order other memory accesses, the decrement
+  /// that reaches zero must see every write made by the other owners.
+  class RcCount {
+  public:
+    explicit RcCount(long value)
+      : value_(value)
+    {
+    }
+
+#ifdef ACE_HAS_CPP11
+    void increment() {
+      value_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long decrement() {
+      return value_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    long value() const {
+      return value_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::atomic<long> value_;
+#else
+    void increment() {
+      ++value_;
+    }
+
+    long decrement() {
+      return --value_;
+    }
+
+    long value() const {
+      return value_.value();
+    }
+
+  private:
+    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> value_;
+#endif
+  };
+
   class RcObject;
 
   class WeakObject : public PoolAllocationBase
@@ -30,13 +77,11 @@ namespace DCPS {
     }
 
     void _add_ref() {
-      ++this->ref_count_;
+      ref_count_.increment();
     }
 
     void _remove_ref(){
-      const long new_count = --this->ref_count_;
-
-      if (new_count == 0) {
+      if (ref_count_.decrement() == 0) {
         delete this;
       }
     }
@@ -44,7 +89,7 @@ namespace DCPS {
     RcObject* lock();
     bool set_expire();
   private:
-    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> ref_count_;
+    RcCount ref_count_;
     ACE_SYNCH_MUTEX mx_;
     RcObject* const ptr_;
     bool expired_;
@@ -54,43 +99,81 @@ namespace DCPS {
   public:
 
     virtual ~RcObject(){
-      weak_object_->_remove_ref();
+      WeakObject* const weak = weak_object();
+      if (weak) {
+        weak->_remove_ref();
+      }
     }
 
     virtual void _add_ref() {
-      ++this->ref_count_;
+      ref_count_.increment();
     }
 
     virtual void _remove_ref() {
-      const long new_count = --this->ref_count_;
-      if (new_count == 0 && weak_object_->set_expire()) {
-        delete this;
+      if (ref_count_.decrement() == 0) {
+        // Only objects that were ever weakly referenced need to synchronize
+        // with WeakObject::lock() before going away.
+        WeakObject* const weak = weak_object();
+        if (!weak || weak->set_expire()) {
+          delete this;
+        }
       }
     }
 
     /// This accessor is purely for debugging purposes
     long ref_count() const {
-      return this->ref_count_.value();
+      return ref_count_.value();
     }
 
+    /// The WeakObject is created by the first WeakRcHandle to this object.
+    /// The caller must hold a strong reference.
     WeakObject*
     _get_weak_object() const {
-      weak_object_->_add_ref();
-      return weak_object_;
+      WeakObject* weak = weak_object();
+#ifdef ACE_HAS_CPP11
+      if (!weak) {
+        WeakObject* const created = new WeakObject(const_cast<RcObject*>(this));
+        if (weak_object_.compare_exchange_strong(weak, created,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+          weak = created;
+        } else {
+          delete created; // another thread won, weak now refers to its object
+        }
+      }
+#endif
+      weak->_add_ref();
+      return weak;
     }
 
   protected:
 
     RcObject()
       : ref_count_(1)
-      , weak_object_( new WeakObject(this) )
+#ifdef ACE_HAS_CPP11
+      , weak_object_(0)
+#else
+      , weak_object_(new WeakObject(this))
+#endif
     {}
 
 
   private:
 
-    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> ref_count_;
-    WeakObject*  weak_object_;
+    WeakObject* weak_object() const {
+#ifdef ACE_HAS_CPP11
+      return weak_object_.load(std::memory_order_acquire);
+#else
+      return weak_object_;
+#endif
+    }
+
+    RcCount ref_count_;
+#ifdef ACE_HAS_CPP11
+    mutable std::atomic<WeakObject*> weak_object_;
+#else
+    WeakObject* weak_object_;
+#endif
 
     RcObject(const RcObject&);
     RcObject& operator=(const RcObject&);
@@ -10,11 +10,13 @@
 
 #include "ace/Atomic_Op_T.h"
 #include "ace/Thread_Mutex.h"
+#include "ace/Log_Msg.h"
 
 #include "dcps_export.h"
 #include "Definitions.h"
 #include "GuidUtils.h"
 #include "DataSampleHeader.h"
+#include "Serializer.h"
 #include "Time_Helper.h"
 #include "unique_ptr.h"
 
@@ -43,6 +45,8 @@ public:
       publisher_id_(header.publisher_id_),
 #endif
       valid_data_(received_data != 0),
+      serialized_swap_(false),
+      serialized_cdr_(false),
       disposed_generation_count_(0),
       no_writers_generation_count_(0),
       zero_copy_cnt_(0),
@@ -85,6 +89,22 @@ public:
     return this->ref_count_.value();
   }
 
+  /// Complete the deserialization of registered_data_ if it was deferred
+  /// when the sample was received.  If that fails, the sample is left
+  /// without valid data.
+  void deserialize()
+  {
+    if (!serialized_) {
+      return;
+    }
+    if (!deserialize_i()) {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: ReceivedDataElement::deserialize: ")
+                 ACE_TEXT("deserialization failed, sample has no valid data.\n")));
+      valid_data_ = false;
+    }
+    serialized_.reset();
+  }
+
   PublicationId pub_;
 
   /**
@@ -117,6 +137,12 @@ public:
   /// Do we contain valid data
   bool valid_data_;
 
+  /// Payload of a sample whose deserialization is deferred until it is
+  /// read or taken, registered_data_ only holds its key members until then.
+  Message_Block_Ptr serialized_;
+  bool serialized_swap_;
+  bool serialized_cdr_;
+
   /// The data sample's instance's disposed_generation_count_
   /// at the time the sample was received
   size_t disposed_generation_count_;
@@ -145,6 +171,8 @@ public:
 private:
   ACE_Atomic_Op<ACE_Thread_Mutex, long> ref_count_;
 protected:
+  virtual bool deserialize_i() { return true; }
+
   ACE_Recursive_Thread_Mutex* mx_;
 }; // class ReceivedDataElement
 
@@ -168,7 +196,26 @@ public:
     ACE_GUARD(ACE_Recursive_Thread_Mutex,
               guard,
               *this->mx_)
-    delete static_cast<DataTypeWithAllocator*> (registered_data_);
+    DataTypeWithAllocator::release(static_cast<DataTypeWithAllocator*>(registered_data_));
+  }
+
+private:
+  bool deserialize_i()
+  {
+    Serializer ser(serialized_.get(), serialized_swap_,
+                   serialized_cdr_ ? Serializer::ALIGN_CDR : Serializer::ALIGN_NONE);
+    if (serialized_cdr_) {
+      ACE_CDR::ULong header;
+      if (!(ser >> header)) {
+        return false;
+      }
+
+      if (Serializer::use_rti_serialization()) {
+        // Start counting byte-offset AFTER header
+        ser.reset_alignment();
+      }
+    }
+    return ser >> *static_cast<DataTypeWithAllocator*>(registered_data_);
   }
 };
 
@@ -122,9 +122,10 @@ Serializer::read_string(ACE_CDR::Char*& dest,
 {
   this->alignment_ == ALIGN_NONE ? 0 : this->align_r(sizeof(ACE_CDR::ULong));
   //
-  // Ensure no bad values leave the routine.
+  // Ensure no bad values leave the routine.  The previous string is
+  // overwritten instead of freed if the new one fits in it.
   //
-  str_free(dest);
+  ACE_CDR::Char* const previous = dest;
   dest = 0;
 
   //
@@ -134,11 +135,13 @@ Serializer::read_string(ACE_CDR::Char*& dest,
   this->buffer_read(reinterpret_cast<char*>(&length), sizeof(ACE_CDR::ULong), this->swap_bytes());
 
   if (!this->good_bit_) {
+    str_free(previous);
     return 0;
   }
 
   if (length == 0) {
     // not legal CDR, but we need to accept it since other implementations may generate this
+    str_free(previous);
     dest = str_alloc(0);
     return 0;
   }
@@ -150,7 +153,12 @@ Serializer::read_string(ACE_CDR::Char*& dest,
   //
   if (length <= this->current_->total_length()) {
 
-    dest = str_alloc(length - 1);
+    if (previous && ACE_OS::strlen(previous) >= length - 1) {
+      dest = previous;
+    } else {
+      str_free(previous);
+      dest = str_alloc(length - 1);
+    }
 
     if (dest == 0) {
       this->good_bit_ = false;
@@ -168,6 +176,7 @@ Serializer::read_string(ACE_CDR::Char*& dest,
     }
 
   } else {
+    str_free(previous);
     good_bit_ = false;
   }
 
@@ -383,6 +383,20 @@ template<typename T> struct KeyOnly {
   T& t;
 };
 
+/// Extracts a full sample only up to its last key member, which is
+/// enough to identify the instance the sample belongs to.
+template<typename T> struct KeyPrefix {
+  explicit KeyPrefix(T& mess) : t(mess) { }
+  T& t;
+};
+
+/// Extracts the members of a full sample that follow its last key
+/// member, continuing where a KeyPrefix extraction stopped.
+template<typename T> struct KeySuffix {
+  explicit KeySuffix(T& mess) : t(mess) { }
+  T& t;
+};
+
 namespace IDL {
   // Although similar to C++11 reference_wrapper, this template has the
   // additional Tag parameter to allow the IDL compiler to generate distinct
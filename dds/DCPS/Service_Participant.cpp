@@ -18,6 +18,7 @@
 #include "RecorderImpl.h"
 #include "ReplayerImpl.h"
 #include "StaticDiscovery.h"
+#include "PublicationThreadPool.h"
 #if defined(OPENDDS_SECURITY)
 #include "security/framework/SecurityRegistry.h"
 #endif
@@ -124,6 +125,7 @@ static bool got_use_rti_serialization = false;
 static bool got_info = false;
 static bool got_chunks = false;
 static bool got_chunk_association_multiplier = false;
+static bool got_publication_threads = false;
 static bool got_liveliness_factor = false;
 static bool got_bit_transport_port = false;
 static bool got_bit_transport_ip = false;
@@ -166,6 +168,7 @@ Service_Participant::Service_Participant()
     defaultDiscovery_(DDS_DEFAULT_DISCOVERY_METHOD),
     n_chunks_(DEFAULT_NUM_CHUNKS),
     association_chunk_multiplier_(DEFAULT_CHUNK_MULTIPLIER),
+    publication_threads_(0),
     liveliness_factor_(80),
     bit_transport_port_(0),
     bit_enabled_(
@@ -271,6 +274,11 @@ Service_Participant::shutdown()
         dp_factory_servant_->cleanup();
       dp_factory_servant_.reset();
 
+      {
+        ACE_GUARD(ACE_Thread_Mutex, pool_guard, publication_thread_pool_lock_);
+        publication_thread_pool_.reset();
+      }
+
       domainRepoMap_.clear();
 
       if (reactor_) {
@@ -498,6 +506,11 @@ Service_Participant::parse_args(int &argc, ACE_TCHAR *argv[])
       arg_shifter.consume_arg();
       got_chunk_association_multiplier = true;
 
+    } else if ((currentArg = arg_shifter.get_the_parameter(ACE_TEXT("-DCPSPublicationThreads"))) != 0) {
+      publication_threads_ = ACE_OS::atoi(currentArg);
+      arg_shifter.consume_arg();
+      got_publication_threads = true;
+
     } else if ((currentArg = arg_shifter.get_the_parameter(ACE_TEXT("-DCPSConfigFile"))) != 0) {
       config_fname = currentArg;
       arg_shifter.consume_arg();
@@ -1315,6 +1328,29 @@ Service_Participant::association_chunk_multiplier(size_t multiplier)
   got_chunk_association_multiplier = true;
 }
 
+size_t
+Service_Participant::publication_threads() const
+{
+  return publication_threads_;
+}
+
+void
+Service_Participant::publication_threads(size_t threads)
+{
+  publication_threads_ = threads;
+  got_publication_threads = true;
+}
+
+PublicationThreadPool&
+Service_Participant::publication_thread_pool()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(publication_thread_pool_lock_);
+  if (!publication_thread_pool_) {
+    publication_thread_pool_.reset(new PublicationThreadPool(publication_threads_));
+  }
+  return *publication_thread_pool_;
+}
+
 void
 Service_Participant::liveliness_factor(int factor)
 {
@@ -1518,6 +1554,12 @@ Service_Participant::load_common_configuration(ACE_Configuration_Heap& cf,
       GET_CONFIG_VALUE(cf, sect, ACE_TEXT("DCPSChunkAssociationMutltiplier"), this->association_chunk_multiplier_, size_t)
     }
 
+    if (got_publication_threads) {
+      ACE_DEBUG((LM_NOTICE, message, ACE_TEXT("DCPSPublicationThreads")));
+    } else {
+      GET_CONFIG_VALUE(cf, sect, ACE_TEXT("DCPSPublicationThreads"), this->publication_threads_, size_t)
+    }
+
     if (got_bit_transport_port) {
       ACE_DEBUG((LM_NOTICE, message, ACE_TEXT("DCPSBitTransportPort")));
     } else {
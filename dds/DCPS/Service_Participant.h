@@ -43,6 +43,7 @@ namespace DCPS {
 class DataDurabilityCache;
 #endif
 class Monitor;
+class PublicationThreadPool;
 
 const char DEFAULT_ORB_NAME[] = "OpenDDS_DCPS";
 
@@ -171,6 +172,19 @@ public:
    */
   void     association_chunk_multiplier(size_t multiplier);
 
+  /// Number of threads of the pool that sends for DataWriters publishing
+  /// asynchronously, 0 for one thread per processor.  Has a default, can be
+  /// set by the @c -DCPSPublicationThreads option, or by
+  /// @c publication_threads() setter before the pool is first used.
+  size_t   publication_threads() const;
+
+  /// Set the value returned by @c publication_threads() accessor.
+  void     publication_threads(size_t threads);
+
+  /// The pool that sends for DataWriters publishing asynchronously,
+  /// started when first used.
+  PublicationThreadPool& publication_thread_pool();
+
   /// Set the Liveliness propagation delay factor.
   /// @param factor % of lease period before sending a liveliness
   ///               message.
@@ -511,6 +525,12 @@ private:
   /// to pre allocate enough memory and reduce heap allocations.
   size_t                                 association_chunk_multiplier_;
 
+  /// The configurable number of publication threads.
+  size_t                                 publication_threads_;
+
+  unique_ptr<PublicationThreadPool>      publication_thread_pool_;
+  ACE_Thread_Mutex                       publication_thread_pool_lock_;
+
   /// The propagation delay factor.
   int                                    liveliness_factor_;
 
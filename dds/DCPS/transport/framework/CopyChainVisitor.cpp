@@ -30,7 +30,8 @@ OpenDDS::DCPS::CopyChainVisitor::visit_element(TransportQueueElement* element)
       element->msg(),
       element->publication_id(),
       this->mb_allocator_,
-      this->db_allocator_
+      this->db_allocator_,
+      this->copies_
     );
 
 
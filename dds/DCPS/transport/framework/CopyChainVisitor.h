@@ -29,7 +29,8 @@ public:
   CopyChainVisitor(
     BasicQueue<TransportQueueElement>& target,
     MessageBlockAllocator*             mb_allocator,
-    DataBlockAllocator*                db_allocator
+    DataBlockAllocator*                db_allocator,
+    TransportQueueElement::DataBlockCopies* copies = 0
   );
 
   virtual ~CopyChainVisitor();
@@ -47,6 +48,9 @@ private:
   MessageBlockAllocator* mb_allocator_;
   DataBlockAllocator* db_allocator_;
 
+  /// Data blocks already copied, shared by the copied elements.
+  TransportQueueElement::DataBlockCopies* copies_;
+
   /// Status of visitation.
   int status_;
 };
@@ -11,10 +11,12 @@ ACE_INLINE
 OpenDDS::DCPS::CopyChainVisitor::CopyChainVisitor(
   BasicQueue<TransportQueueElement>& target,
   MessageBlockAllocator* mb_allocator,
-  DataBlockAllocator* db_allocator
+  DataBlockAllocator* db_allocator,
+  TransportQueueElement::DataBlockCopies* copies
 ) : target_( target)
   , mb_allocator_(mb_allocator)
   , db_allocator_(db_allocator)
+  , copies_(copies)
   , status_( 0)
 {
   DBG_ENTRY_LVL("CopyChainVisitor","CopyChainVisitor",6);
@@ -422,13 +422,19 @@ DataLink::release_reservations(RepoId remote_id, RepoId local_id,
                 ACE_TEXT("(%P|%t) DataLink::release_reservations: ")
                 ACE_TEXT("release_datalink due to no remaining pubs or subs.\n")), 5);
 
-      impl_.release_datalink(this);
+      release_datalink_i();
     }
   }
   if (release_remote_required)
     release_remote_i(remote_id);
 }
 
+void
+DataLink::release_datalink_i()
+{
+  impl_.release_datalink(this);
+}
+
 void
 DataLink::schedule_delayed_release()
 {
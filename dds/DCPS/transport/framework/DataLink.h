@@ -330,6 +330,10 @@ private:
   }
 
   virtual void release_remote_i(const RepoId& /*remote_id*/) {}
+
+  /// Called when the last association is released, by default the link
+  /// is handed back to the TransportImpl that created it.
+  virtual void release_datalink_i();
   virtual void release_reservations_i(const RepoId& /*remote_id*/,
                                       const RepoId& /*local_id*/) {}
 
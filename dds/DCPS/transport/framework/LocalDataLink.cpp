@@ -0,0 +1,143 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+#include "LocalDataLink.h"
+#include "ReceivedDataSample.h"
+#include "TransportQueueElement.h"
+#include "TransportImpl.h"
+#include "TransportReactorTask.h"
+
+#include "EntryExit.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+LocalDataLink::LocalDataLink(TransportImpl& impl, Priority priority,
+                             bool is_active)
+  : DataLink(impl, priority, true /*is_loopback*/, is_active)
+  , delivery_handler_(this)
+{
+}
+
+void
+LocalDataLink::pair(const LocalDataLink_rch& a, const LocalDataLink_rch& b)
+{
+  a->peer_ = static_rchandle_cast<DataLink>(b);
+  b->peer_ = static_rchandle_cast<DataLink>(a);
+}
+
+void
+LocalDataLink::send_i(TransportQueueElement* element, bool /*relink*/)
+{
+  DBG_ENTRY_LVL("LocalDataLink", "send_i", 6);
+
+  const DataLink_rch peer = peer_.lock();
+  if (!peer) {
+    element->data_dropped(true);
+    return;
+  }
+
+  // Demarshal the header the same way a receive strategy would, the
+  // data that follows it is delivered as is.
+  Message_Block_Ptr data(element->msg()->duplicate());
+  ReceivedDataSample sample(0);
+  sample.header_ = DataSampleHeader(*data);
+
+  while (data->length() == 0 && data->cont()) {
+    ACE_Message_Block* const payload = data->cont();
+    data->cont(0);
+    data.reset(payload);
+  }
+  sample.sample_ = move(data);
+
+  delivery_handler_.enqueue(element, sample);
+}
+
+void
+LocalDataLink::release_datalink_i()
+{
+  delivery_handler_.drop_all();
+}
+
+int
+LocalDataLink::DeliveryHandler::handle_exception(ACE_HANDLE /* fd */)
+{
+  Queue queue;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+    queue.swap(queue_);
+  }
+
+  const DataLink_rch peer = link_->peer_.lock();
+  for (Queue::iterator itr = queue.begin(); itr != queue.end(); ++itr) {
+    if (peer) {
+      peer->data_received(itr->second);
+      itr->first->data_delivered();
+    } else {
+      itr->first->data_dropped(true);
+    }
+  }
+  return 0;
+}
+
+void
+LocalDataLink::DeliveryHandler::enqueue(TransportQueueElement* element,
+                                        const ReceivedDataSample& sample)
+{
+  const TransportReactorTask_rch task = link_->impl().reactor_task();
+  if (task.is_nil()) {
+    // TransportClient only pairs links of transports that have a reactor
+    // task, it's gone once the transport is shut down.
+    element->data_dropped(true);
+    return;
+  }
+
+  bool notify;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    // A notification is pending while the queue is not empty.
+    notify = queue_.empty();
+    queue_.push_back(Entry(element, sample));
+  }
+  if (notify) {
+    task->get_reactor()->notify(this);
+  }
+}
+
+void
+LocalDataLink::DeliveryHandler::drop_all()
+{
+  Queue queue;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    queue.swap(queue_);
+  }
+
+  for (Queue::iterator itr = queue.begin(); itr != queue.end(); ++itr) {
+    itr->first->data_dropped(true);
+  }
+}
+
+ACE_Event_Handler::Reference_Count
+LocalDataLink::DeliveryHandler::add_reference()
+{
+  return link_->add_reference();
+}
+
+ACE_Event_Handler::Reference_Count
+LocalDataLink::DeliveryHandler::remove_reference()
+{
+  return link_->remove_reference();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,95 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LOCALDATALINK_H
+#define OPENDDS_DCPS_LOCALDATALINK_H
+
+#include "dds/DCPS/dcps_export.h"
+#include "DataLink.h"
+#include "ReceivedDataSample.h"
+
+#include "ace/Thread_Mutex.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class LocalDataLink;
+typedef RcHandle<LocalDataLink> LocalDataLink_rch;
+
+/**
+ * @class LocalDataLink
+ *
+ * @brief DataLink between two TransportClients of the same process.
+ *
+ * The links are created in pairs by TransportClient::associate() when the
+ * TransportConfig of both sides enables local_delivery_.  Instead of
+ * going through a send strategy, a sample sent on one link is handed to
+ * the data_received() of its peer link from the transport's reactor
+ * thread, so it reaches the receive listeners (and their QoS, content
+ * filters and listeners) without a socket or receive strategy in between.
+ * The sending thread only queues the sample: it may hold the writer's
+ * send_transaction_lock_, which a listener writing back would need.
+ * The payload is shared with the sender's message blocks, not copied.
+ */
+class OpenDDS_Dcps_Export LocalDataLink : public DataLink {
+public:
+  LocalDataLink(TransportImpl& impl, Priority priority, bool is_active);
+
+  /// Connect a and b to each other.
+  static void pair(const LocalDataLink_rch& a, const LocalDataLink_rch& b);
+
+protected:
+  virtual void send_i(TransportQueueElement* element, bool relink = true);
+
+private:
+  /// The link is not known to impl(), there is nothing to hand back.
+  /// Samples not delivered yet are dropped.
+  virtual void release_datalink_i();
+
+  /// The peer link, weak since both links refer to each other.
+  WeakRcHandle<DataLink> peer_;
+
+  /// Delivers the queued samples to the peer on the reactor thread.
+  class DeliveryHandler : public RcEventHandler {
+  public:
+    explicit DeliveryHandler(LocalDataLink* link)
+      : link_(link) {
+      }
+
+    /// Reactor invokes this after being notified in enqueue()
+    int handle_exception(ACE_HANDLE /* fd */);
+
+    void enqueue(TransportQueueElement* element,
+                 const ReceivedDataSample& sample);
+
+    /// Drop the samples not delivered yet.
+    void drop_all();
+
+    virtual ACE_Event_Handler::Reference_Count add_reference();
+    virtual ACE_Event_Handler::Reference_Count remove_reference();
+  private:
+    LocalDataLink* link_;
+    typedef std::pair<TransportQueueElement*, ReceivedDataSample> Entry;
+    typedef OPENDDS_VECTOR(Entry) Queue;
+    ACE_Thread_Mutex lock_;
+    Queue queue_;
+  };
+  DeliveryHandler delivery_handler_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LOCALDATALINK_H */
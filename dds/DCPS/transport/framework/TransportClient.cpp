@@ -12,6 +12,7 @@
 #include "TransportRegistry.h"
 #include "TransportExceptions.h"
 #include "TransportReceiveListener.h"
+#include "LocalDataLink.h"
 
 #include "dds/DdsDcpsInfoUtilsC.h"
 
@@ -39,6 +40,9 @@ TransportClient::TransportClient()
   , cdr_encapsulation_(false)
   , reliable_(false)
   , durable_(false)
+  , local_delivery_(false)
+  , local_impl_(0)
+  , topic_conn_info_(false)
   , reverse_lock_(lock_)
   , repo_id_(GUID_UNKNOWN)
 {
@@ -142,7 +146,10 @@ TransportClient::enable_transport_using_config(bool reliable, bool durable,
         impls_.push_back(impl);
         const CORBA::ULong len = conn_info_.length();
         conn_info_.length(len + 1);
-        impl->connection_info(conn_info_[len]);
+        const OPENDDS_STRING topic_name = transport_topic_name();
+        impl->connection_info(conn_info_[len], transport_participant_id(),
+                              topic_name);
+        topic_conn_info_ |= !topic_name.empty();
 
 #if defined(OPENDDS_SECURITY)
         impl->local_crypto_handle(get_crypto_handle());
@@ -159,6 +166,30 @@ TransportClient::enable_transport_using_config(bool reliable, bool durable,
                ACE_TEXT("No TransportImpl could be created.\n")));
     throw Transport::NotConfigured();
   }
+
+  // LocalDataLinks deliver from the reactor thread of one of our
+  // transports, without one (shmem has none) local delivery is left off
+  // and the peer associates over the configured transports.
+  local_delivery_ = false;
+  local_impl_ = 0;
+  if (tc->local_delivery_) {
+    for (size_t i = 0; i < impls_.size() && !local_impl_; ++i) {
+      if (!impls_[i]->reactor_task().is_nil()) {
+        local_impl_ = impls_[i];
+      }
+    }
+    if (local_impl_) {
+      local_delivery_ = true;
+      const CORBA::ULong len = conn_info_.length();
+      conn_info_.length(len + 1);
+      TransportRegistry::instance()->local_locator(conn_info_[len]);
+    } else {
+      ACE_DEBUG((LM_WARNING,
+                 ACE_TEXT("(%P|%t) WARNING: TransportClient::enable_transport_using_config ")
+                 ACE_TEXT("local_delivery ignored, none of the transports ")
+                 ACE_TEXT("has a reactor thread to deliver from\n")));
+    }
+  }
 }
 
 
@@ -233,6 +264,10 @@ TransportClient::associate(const AssociationData& data, bool active)
   pend->attribs_.local_reliable_ = reliable_;
   pend->attribs_.local_durable_ = durable_;
 
+  if (local_delivery_ && TransportRegistry::instance()->is_local(data.remote_data_)) {
+    return associate_local(data.remote_id_, pend->attribs_.priority_, guard);
+  }
+
   if (active) {
     pend->impls_.reserve(impls_.size());
     std::reverse_copy(impls_.begin(), impls_.end(),
@@ -295,6 +330,58 @@ TransportClient::associate(const AssociationData& data, bool active)
   return true;
 }
 
+bool
+TransportClient::associate_local(const RepoId& remote_id, Priority priority,
+                                 Guard& guard)
+{
+  const RepoId local_id(repo_id_);
+  TransportClient_rch peer;
+  {
+    // The peer may be completing its side of the rendezvous, which needs
+    // its lock_ and then ours.
+    ACE_GUARD_RETURN(Reverse_Lock_t, unlock_guard, reverse_lock_, false);
+    peer = TransportRegistry::instance()->local_rendezvous(local_id, remote_id,
+                                                           rchandle_from(this));
+  }
+
+  if (!peer) {
+    // The peer completes both sides once it associates with us.
+    return true;
+  }
+
+  if (pending_.find(remote_id) == pending_.end()) {
+    // stop_associating() was called meanwhile
+    return true;
+  }
+
+  GuidConverter local_conv(local_id);
+  GuidConverter remote_conv(remote_id);
+  VDBG_LVL((LM_DEBUG, "(%P|%t) TransportClient::associate_local "
+            "local %C remote %C\n",
+            OPENDDS_STRING(local_conv).c_str(),
+            OPENDDS_STRING(remote_conv).c_str()), 2);
+
+  const LocalDataLink_rch link =
+    make_rch<LocalDataLink>(ref(*local_impl_), priority, true);
+  const LocalDataLink_rch peer_link =
+    make_rch<LocalDataLink>(ref(*peer->local_impl_), priority, false);
+  LocalDataLink::pair(link, peer_link);
+
+  // Complete the reader's side first so that samples the writer sends as
+  // soon as it is associated find the reader's reservation.
+  if (get_receive_listener()) {
+    use_datalink_i(remote_id, static_rchandle_cast<DataLink>(link), guard);
+    peer->use_datalink(local_id, static_rchandle_cast<DataLink>(peer_link));
+  } else {
+    {
+      ACE_GUARD_RETURN(Reverse_Lock_t, unlock_guard, reverse_lock_, false);
+      peer->use_datalink(local_id, static_rchandle_cast<DataLink>(peer_link));
+    }
+    use_datalink_i(remote_id, static_rchandle_cast<DataLink>(link), guard);
+  }
+  return true;
+}
+
 int
 TransportClient::PendingAssoc::handle_timeout(const ACE_Time_Value&,
                                               const void* arg)
@@ -542,6 +629,17 @@ TransportClient::stop_associating()
 {
   ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
   pending_.clear();
+  if (local_delivery_) {
+    TransportRegistry::instance()->local_rendezvous_cancel(repo_id_);
+  }
+
+  // No further associations will use the per-topic locators
+  if (topic_conn_info_) {
+    topic_conn_info_ = false;
+    for (size_t i = 0; i < impls_.size() && i < conn_info_.length(); ++i) {
+      impls_[i]->release_connection_info(conn_info_[i]);
+    }
+  }
 }
 
 void
@@ -554,6 +652,9 @@ TransportClient::stop_associating(const GUID_t* repos, CORBA::ULong length)
   } else {
     for (CORBA::ULong i = 0; i < length; ++i) {
       pending_.erase(repos[i]);
+      if (local_delivery_) {
+        TransportRegistry::instance()->local_rendezvous_cancel(repo_id_, repos[i]);
+      }
     }
   }
 }
@@ -135,6 +135,14 @@ private:
   virtual Priority get_priority_value(const AssociationData& data) const = 0;
   virtual void transport_assoc_done(int /*flags*/, const RepoId& /*remote*/) {}
 
+  /// Name of the topic whose samples are received, transports may
+  /// advertise per-topic locators for it.  Empty when not receiving.
+  virtual OPENDDS_STRING transport_topic_name() const { return OPENDDS_STRING(); }
+
+  /// Participant of the TransportClient that reads transport_topic_name(),
+  /// already known when the locators are made, unlike get_repo_id().
+  virtual RepoId transport_participant_id() const { return GUID_UNKNOWN; }
+
 #if defined(OPENDDS_SECURITY)
   virtual DDS::Security::ParticipantCryptoHandle get_crypto_handle() const
   {
@@ -147,6 +155,11 @@ private:
   void use_datalink_i(const RepoId& remote_id,
                       const DataLink_rch& link,
                       Guard& guard);
+
+  /// associate() with a remote endpoint in this process over a pair of
+  /// LocalDataLinks, once both endpoints are associating.
+  bool associate_local(const RepoId& remote_id, Priority priority,
+                       Guard& guard);
   TransportSendListener_rch get_send_listener();
   TransportReceiveListener_rch get_receive_listener();
 
@@ -290,12 +303,19 @@ private:
 
   // Configuration details:
 
-  bool swap_bytes_, cdr_encapsulation_, reliable_, durable_;
+  bool swap_bytes_, cdr_encapsulation_, reliable_, durable_, local_delivery_;
+
+  /// The transport whose reactor thread our LocalDataLinks deliver from.
+  TransportImpl* local_impl_;
 
   ACE_Time_Value passive_connect_duration_;
 
   TransportLocatorSeq conn_info_;
 
+  /// conn_info_ was made for transport_topic_name(), stop_associating()
+  /// releases it.
+  bool topic_conn_info_;
+
   /// Seems to protect accesses to impls_, pending_, links_, data_link_index_
   ACE_Thread_Mutex lock_;
 
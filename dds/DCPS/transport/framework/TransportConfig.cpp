@@ -17,6 +17,7 @@ namespace DCPS {
 TransportConfig::TransportConfig(const OPENDDS_STRING& name)
   : swap_bytes_(false)
   , passive_connect_duration_(DEFAULT_PASSIVE_CONNECT_DURATION)
+  , local_delivery_(false)
   , name_(name)
 {}
 
@@ -42,6 +42,13 @@ public:
   /// The default is 60 seconds
   unsigned long passive_connect_duration_;
 
+  /// Associate endpoints that are both in this process, and both use a
+  /// config with local_delivery_ enabled, over a LocalDataLink instead of
+  /// the configured transports.  Samples are then delivered from the
+  /// reactor thread of the first transport that has one, local_delivery_
+  /// is ignored if none does.  The default is false.
+  bool local_delivery_;
+
   /// Insert the TransportInst in sorted order (by name) in the instances_ list.
   /// Use when the names of the TransportInst objects are specifically assigned
   /// to have the sorted order make sense.
@@ -9,6 +9,7 @@
 #include "TransportImpl.h"
 #include "DataLink.h"
 #include "TransportExceptions.h"
+#include "TransportRegistry.h"
 #include "dds/DCPS/BuiltInTopicUtils.h"
 #include "dds/DCPS/DataWriterImpl.h"
 #include "dds/DCPS/DataReaderImpl.h"
@@ -31,6 +32,7 @@ namespace DCPS {
 
 TransportImpl::TransportImpl(TransportInst& config)
   : config_(config)
+  , reactor_task_shared_(false)
   , monitor_(0)
   , last_link_(0)
   , is_shut_down_(false)
@@ -62,12 +64,16 @@ TransportImpl::shutdown()
   // Stop datalink clean task.
   this->dl_clean_task_.close(1);
 
-  if (!this->reactor_task_.is_nil()) {
+  if (!this->reactor_task_.is_nil() && !reactor_task_shared_) {
     this->reactor_task_->stop();
   }
 
   // Tell our subclass about the "shutdown event".
-  this->shutdown_i();
+  if (reactor_task_shared_) {
+    make_rch<ShutdownInterceptor>(ref(*this))->shutdown();
+  } else {
+    this->shutdown_i();
+  }
 }
 
 
@@ -106,12 +112,20 @@ TransportImpl::add_pending_connection(const TransportClient_rch& client, DataLin
 }
 
 void
-TransportImpl::create_reactor_task(bool useAsyncSend)
+TransportImpl::create_reactor_task(bool useAsyncSend, bool shared)
 {
   if (is_shut_down_ || this->reactor_task_.in()) {
     return;
   }
 
+  if (shared && !useAsyncSend) {
+    this->reactor_task_ = TheTransportRegistry->shared_reactor_task();
+    if (this->reactor_task_.in()) {
+      reactor_task_shared_ = true;
+      return;
+    }
+  }
+
   this->reactor_task_= make_rch<TransportReactorTask>(useAsyncSend);
   if (0 != this->reactor_task_->open(0)) {
     throw Transport::MiscProblem(); // error already logged by TRT::open()
@@ -21,6 +21,7 @@
 #include "DataLinkCleanupTask.h"
 #include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/DiscoveryListener.h"
+#include "dds/DCPS/ReactorInterceptor.h"
 
 #if defined(OPENDDS_SECURITY)
 #include "dds/DdsSecurityCoreC.h"
@@ -82,6 +83,21 @@ public:
   /// TransportLocator object.
   virtual bool connection_info_i(TransportLocator& local_info) const = 0;
 
+  /// Variation of connection_info_i() for a TransportClient of
+  /// participant that reads topic_name, for transports that advertise
+  /// per-topic locators.  The default ignores the topic.
+  virtual bool topic_connection_info_i(TransportLocator& local_info,
+                                       const RepoId& /*participant*/,
+                                       const OPENDDS_STRING& /*topic_name*/)
+  {
+    return connection_info_i(local_info);
+  }
+
+  /// Called when the TransportClient that got local_info from
+  /// topic_connection_info_i() stops using it, so the transport can
+  /// release what it set up for the topic.  The default does nothing.
+  virtual void release_topic_connection_info_i(const TransportLocator& /*local_info*/) {}
+
   virtual void register_for_reader(const RepoId& /*participant*/,
                                    const RepoId& /*writerid*/,
                                    const RepoId& /*readerid*/,
@@ -110,8 +126,9 @@ public:
   bool is_shut_down() const;
 
   /// Create the reactor task using sync send or optionally async send
-  /// by parameter on supported Windows platforms only.
-  void create_reactor_task(bool useAsyncSend = false);
+  /// by parameter on supported Windows platforms only.  With shared, use
+  /// the TransportRegistry's shared reactor task instead of a new one.
+  void create_reactor_task(bool useAsyncSend = false, bool shared = false);
 
   /// Diagnostic aid.
   void dump();
@@ -255,6 +272,10 @@ public:
   /// with this TransportImpl's connection information (ie, how
   /// another process would connect to this TransportImpl).
   bool connection_info(TransportLocator& local_info) const;
+  bool connection_info(TransportLocator& local_info,
+                       const RepoId& participant,
+                       const OPENDDS_STRING& topic_name);
+  void release_connection_info(const TransportLocator& local_info);
 
   typedef ACE_SYNCH_MUTEX     LockType;
   typedef ACE_Guard<LockType> GuardType;
@@ -270,6 +291,50 @@ public:
   /// subclass (of TransportImpl) doesn't require a reactor.
   TransportReactorTask_rch reactor_task_;
 
+  /// The reactor_task_ is the shared one, it outlives this transport.
+  bool reactor_task_shared_;
+
+  /// Runs shutdown_i() on the thread of a shared reactor_task_, which
+  /// keeps running for other transports, so the subclass removes its
+  /// handlers and cancels its timers while none of them is dispatched.
+  class ShutdownInterceptor : public ReactorInterceptor {
+  public:
+    explicit ShutdownInterceptor(TransportImpl& impl)
+      : ReactorInterceptor(impl.reactor_task_->get_reactor(),
+                           impl.reactor_task_->get_reactor_owner())
+      , impl_(impl)
+    { }
+
+    void shutdown()
+    {
+      ShutdownCommand c(impl_);
+      execute_or_enqueue(c);
+      wait();
+    }
+
+    virtual bool reactor_is_shut_down() const
+    {
+      return impl_.reactor_task_->is_shut_down();
+    }
+
+  private:
+    ~ShutdownInterceptor()
+    { }
+
+    struct ShutdownCommand : public Command {
+      explicit ShutdownCommand(TransportImpl& impl)
+        : impl_(impl)
+      { }
+      virtual void execute()
+      {
+        impl_.shutdown_i();
+      }
+      TransportImpl& impl_;
+    };
+
+    TransportImpl& impl_;
+  };
+
   /// smart ptr to the associated DL cleanup task
   DataLinkCleanupTask dl_clean_task_;
 
@@ -54,5 +54,20 @@ OpenDDS::DCPS::TransportImpl::connection_info
   return this->connection_info_i(local_info);
 }
 
+ACE_INLINE bool
+OpenDDS::DCPS::TransportImpl::connection_info
+  (TransportLocator& local_info, const RepoId& participant,
+   const OPENDDS_STRING& topic_name)
+{
+  return this->topic_connection_info_i(local_info, participant, topic_name);
+}
+
+ACE_INLINE void
+OpenDDS::DCPS::TransportImpl::release_connection_info
+  (const TransportLocator& local_info)
+{
+  this->release_topic_connection_info_i(local_info);
+}
+
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
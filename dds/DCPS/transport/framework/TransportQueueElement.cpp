@@ -60,7 +60,8 @@ TransportQueueElement::fragment(size_t size)
 ACE_Message_Block*
 TransportQueueElement::clone_mb(const ACE_Message_Block* msg,
                                 MessageBlockAllocator* mb_allocator,
-                                DataBlockAllocator* db_allocator)
+                                DataBlockAllocator* db_allocator,
+                                DataBlockCopies* copies)
 {
   ACE_Message_Block* cur_block = const_cast<ACE_Message_Block*>(msg);
   ACE_Message_Block* head_copy = 0;
@@ -68,23 +69,49 @@ TransportQueueElement::clone_mb(const ACE_Message_Block* msg,
   ACE_Message_Block* prev_copy = 0;
   // deep copy sample data
   while (cur_block != 0) {
-    ACE_NEW_MALLOC_RETURN(cur_copy,
-                          static_cast<ACE_Message_Block*>(
-                          mb_allocator->malloc(sizeof(ACE_Message_Block))),
-                          ACE_Message_Block(cur_block->capacity(),
-                                            ACE_Message_Block::MB_DATA,
-                                            0, //cont
-                                            0, //data
-                                            0, //alloc_strategy
-                                            0, //locking_strategy
-                                            ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
-                                            ACE_Time_Value::zero,
-                                            ACE_Time_Value::max_time,
-                                            db_allocator,
-                                            mb_allocator),
-                          0);
-
-    cur_copy->copy(cur_block->base(), cur_block->size());
+    ACE_Data_Block* shared = 0;
+    if (copies) {
+      const DataBlockCopies::const_iterator it =
+        copies->find(cur_block->data_block());
+      if (it != copies->end()) {
+        shared = it->second;
+      }
+    }
+
+    if (shared) {
+      // already copied for an earlier block, only reference it
+      ACE_NEW_MALLOC_RETURN(cur_copy,
+                            static_cast<ACE_Message_Block*>(
+                            mb_allocator->malloc(sizeof(ACE_Message_Block))),
+                            ACE_Message_Block(shared->duplicate(),
+                                              0, //flags
+                                              mb_allocator),
+                            0);
+
+    } else {
+      ACE_NEW_MALLOC_RETURN(cur_copy,
+                            static_cast<ACE_Message_Block*>(
+                            mb_allocator->malloc(sizeof(ACE_Message_Block))),
+                            ACE_Message_Block(cur_block->capacity(),
+                                              ACE_Message_Block::MB_DATA,
+                                              0, //cont
+                                              0, //data
+                                              0, //alloc_strategy
+                                              0, //locking_strategy
+                                              ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                                              ACE_Time_Value::zero,
+                                              ACE_Time_Value::max_time,
+                                              db_allocator,
+                                              mb_allocator),
+                            0);
+
+      cur_copy->copy(cur_block->base(), cur_block->size());
+
+      if (copies) {
+        (*copies)[cur_block->data_block()] = cur_copy->data_block();
+      }
+    }
+
     cur_copy->rd_ptr(cur_copy->base() +
                      (cur_block->rd_ptr() - cur_block->base()));
     cur_copy->wr_ptr(cur_copy->base() +
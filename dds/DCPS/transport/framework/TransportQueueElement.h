@@ -12,12 +12,14 @@
 #include "dds/DCPS/Definitions.h"
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/PoolAllocationBase.h"
+#include "dds/DCPS/PoolAllocator.h"
 #include "dds/DCPS/SequenceNumber.h"
 
 #include <utility>
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Message_Block;
+class ACE_Data_Block;
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -125,11 +127,16 @@ public:
   bool released() const;
   void released(bool flag);
 
+  /// Data blocks already copied by clone_mb(), by the original block.
+  typedef OPENDDS_MAP(const ACE_Data_Block*, ACE_Data_Block*) DataBlockCopies;
+
   /// Clone method with provided message block allocator and data block
-  /// allocators.
+  /// allocators.  When copies is given, data blocks found in it are shared
+  /// instead of copied again and the new copies are added to it.
   static ACE_Message_Block* clone_mb(const ACE_Message_Block* msg,
                                      MessageBlockAllocator* mb_allocator,
-                                     DataBlockAllocator* db_allocator);
+                                     DataBlockAllocator* db_allocator,
+                                     DataBlockCopies* copies = 0);
 
   /// Is the sample created by the transport?
   virtual bool owned_by_transport() = 0;
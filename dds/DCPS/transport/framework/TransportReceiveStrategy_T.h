@@ -13,6 +13,7 @@
 #include "TransportStrategy.h"
 #include "TransportDefs.h"
 #include "TransportHeader.h"
+#include "dds/DCPS/DataBlockLockPool.h"
 
 #include "ace/INET_Addr.h"
 #include "ace/Lock_Adapter_T.h"
@@ -128,7 +129,7 @@ private:
   TransportDataAllocator         data_allocator_;
 
   /// Locking strategy for the allocators.
-  ACE_Lock_Adapter<ACE_SYNCH_MUTEX> receive_lock_;
+  DataBlockLockPool::DataBlockLock receive_lock_;
 
   /// Set of receive buffers in use.
   ACE_Message_Block* receive_buffers_[RECEIVE_BUFFERS];
@@ -10,7 +10,9 @@
 #include "TransportDebug.h"
 #include "TransportInst.h"
 #include "TransportExceptions.h"
+#include "TransportReactorTask.h"
 #include "TransportType.h"
+#include "TransportClient.h"
 #include "dds/DCPS/Util.h"
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/EntityImpl.h"
@@ -19,6 +21,9 @@
 
 #include "ace/Singleton.h"
 #include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_time.h"
 #include "ace/Service_Config.h"
 
 #if !defined (__ACE_INLINE__)
@@ -42,6 +47,9 @@ namespace {
 #else
   const char FALLBACK_TYPE[] = "tcp";
 #endif
+
+  // transport type of the locator added for local delivery
+  const char LOCAL_TYPE[] = "local";
 }
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -71,6 +79,12 @@ TransportRegistry::TransportRegistry()
   DBG_ENTRY_LVL("TransportRegistry", "TransportRegistry", 6);
   config_map_[DEFAULT_CONFIG_NAME] = global_config_;
 
+  char host[MAXHOSTNAMELEN + 1] = "";
+  ACE_OS::hostname(host, sizeof host);
+  local_token_ = OPENDDS_STRING(host) + ':'
+    + to_dds_string(static_cast<long>(ACE_OS::getpid())) + ':'
+    + to_dds_string(static_cast<unsigned long long>(ACE_OS::gethrtime()));
+
   lib_directive_map_["tcp"]       = "dynamic OpenDDS_Tcp Service_Object * OpenDDS_Tcp:_make_TcpLoader()";
   lib_directive_map_["udp"]       = "dynamic OpenDDS_Udp Service_Object * OpenDDS_Udp:_make_UdpLoader()";
   lib_directive_map_["multicast"] = "dynamic OpenDDS_Multicast Service_Object * OpenDDS_Multicast:_make_MulticastLoader()";
@@ -255,6 +269,16 @@ TransportRegistry::load_transport_configuration(const OPENDDS_STRING& file_name,
                                   value.c_str(), config_id.c_str()),
                                  -1);
               }
+            } else if (name == "local_delivery") {
+              if ((value == "1") || (value == "true")) {
+                config->local_delivery_ = true;
+              } else if ((value != "0") && (value != "false")) {
+                ACE_ERROR_RETURN((LM_ERROR,
+                                  ACE_TEXT("(%P|%t) TransportRegistry::load_transport_configuration: ")
+                                  ACE_TEXT("Illegal value for local_delivery (%C) in [config/%C] section.\n"),
+                                  value.c_str(), config_id.c_str()),
+                                 -1);
+              }
             } else {
               ACE_ERROR_RETURN((LM_ERROR,
                                 ACE_TEXT("(%P|%t) TransportRegistry::load_transport_configuration: ")
@@ -510,6 +534,12 @@ TransportRegistry::release()
   config_map_.clear();
   domain_default_config_map_.clear();
   global_config_.reset();
+  local_waiting_.clear();
+
+  if (shared_reactor_task_) {
+    shared_reactor_task_->stop();
+    shared_reactor_task_.reset();
+  }
 }
 
 bool
@@ -519,6 +549,88 @@ TransportRegistry::released() const
   return released_;
 }
 
+TransportReactorTask_rch
+TransportRegistry::shared_reactor_task()
+{
+  GuardType guard(lock_);
+  if (!shared_reactor_task_ && !released_) {
+    shared_reactor_task_ = make_rch<TransportReactorTask>(false);
+    if (0 != shared_reactor_task_->open(0)) {
+      shared_reactor_task_.reset();
+      throw Transport::MiscProblem(); // error already logged by TRT::open()
+    }
+  }
+  return shared_reactor_task_;
+}
+
+void
+TransportRegistry::local_locator(TransportLocator& locator) const
+{
+  locator.transport_type = LOCAL_TYPE;
+  locator.data.length(static_cast<CORBA::ULong>(local_token_.size()));
+  std::memcpy(locator.data.get_buffer(), local_token_.data(), local_token_.size());
+}
+
+bool
+TransportRegistry::is_local(const TransportLocatorSeq& locators) const
+{
+  for (CORBA::ULong i = 0; i < locators.length(); ++i) {
+    const TransportLocator& locator = locators[i];
+    if (std::strcmp(locator.transport_type.in(), LOCAL_TYPE) == 0
+        && locator.data.length() == local_token_.size()
+        && std::memcmp(locator.data.get_buffer(), local_token_.data(),
+                       local_token_.size()) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TransportClient_rch
+TransportRegistry::local_rendezvous(const RepoId& local,
+                                    const RepoId& remote,
+                                    const TransportClient_rch& client)
+{
+  GuardType guard(lock_);
+  const LocalWaiting::iterator waiting = local_waiting_.find(remote);
+  if (waiting != local_waiting_.end()) {
+    const LocalPeers::iterator peer = waiting->second.find(local);
+    if (peer != waiting->second.end()) {
+      const TransportClient_rch remote_client = peer->second.lock();
+      waiting->second.erase(peer);
+      if (waiting->second.empty()) {
+        local_waiting_.erase(waiting);
+      }
+      if (remote_client) {
+        return remote_client;
+      }
+    }
+  }
+  local_waiting_[local][remote] = client;
+  return TransportClient_rch();
+}
+
+void
+TransportRegistry::local_rendezvous_cancel(const RepoId& local)
+{
+  GuardType guard(lock_);
+  local_waiting_.erase(local);
+}
+
+void
+TransportRegistry::local_rendezvous_cancel(const RepoId& local,
+                                           const RepoId& remote)
+{
+  GuardType guard(lock_);
+  const LocalWaiting::iterator waiting = local_waiting_.find(local);
+  if (waiting != local_waiting_.end()) {
+    waiting->second.erase(remote);
+    if (waiting->second.empty()) {
+      local_waiting_.erase(waiting);
+    }
+  }
+}
+
 }
 }
 
@@ -17,7 +17,9 @@
 #include "TransportInst_rch.h"
 #include "TransportConfig_rch.h"
 #include "TransportConfig.h"
+#include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/PoolAllocator.h"
+#include "dds/DdsDcpsInfoUtilsC.h"
 #include "ace/Synch_Traits.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -36,6 +38,10 @@ namespace DDS {
 namespace OpenDDS {
 namespace DCPS {
 
+class TransportClient;
+typedef RcHandle<TransportClient> TransportClient_rch;
+typedef WeakRcHandle<TransportClient> TransportClient_wrch;
+
 /**
  * The TransportRegistry is a singleton object which provides a mechanism to
  * the application code to configure OpenDDS's use of the transport layer.
@@ -111,6 +117,27 @@ public:
 
   bool released() const;
 
+  /// For internal use by OpenDDS DCPS layer:
+  /// The reactor task shared by the transports configured to use one
+  /// instead of their own, created on first use and stopped by release().
+  TransportReactorTask_rch shared_reactor_task();
+
+  /// For internal use by OpenDDS DCPS layer:
+  /// The locator that TransportClients configured for local delivery add
+  /// to their connection info, it identifies this process.
+  void local_locator(TransportLocator& locator) const;
+  bool is_local(const TransportLocatorSeq& locators) const;
+
+  /// For internal use by OpenDDS DCPS layer:
+  /// Meet the TransportClient of remote, in this process, that local is
+  /// associating with.  Returns that client if it is already waiting for
+  /// local, otherwise client waits for remote and nil is returned.
+  TransportClient_rch local_rendezvous(const RepoId& local,
+                                       const RepoId& remote,
+                                       const TransportClient_rch& client);
+  void local_rendezvous_cancel(const RepoId& local);
+  void local_rendezvous_cancel(const RepoId& local, const RepoId& remote);
+
 private:
   friend class ACE_Singleton<TransportRegistry, ACE_Recursive_Thread_Mutex>;
 
@@ -133,8 +160,17 @@ private:
   DomainConfigMap domain_default_config_map_;
 
   TransportConfig_rch global_config_;
+  TransportReactorTask_rch shared_reactor_task_;
   bool released_;
 
+  /// Identifies this process in local_locator().
+  OPENDDS_STRING local_token_;
+
+  /// TransportClients waiting for a local peer: local id -> remote id.
+  typedef OPENDDS_MAP_CMP(RepoId, TransportClient_wrch, GUID_tKeyLessThan) LocalPeers;
+  typedef OPENDDS_MAP_CMP(RepoId, LocalPeers, GUID_tKeyLessThan) LocalWaiting;
+  LocalWaiting local_waiting_;
+
   mutable LockType lock_;
 };
 
@@ -28,7 +28,8 @@ public:
     const ACE_Message_Block*           message,
     const RepoId&                      pubId,
     MessageBlockAllocator*             mb_allocator_ = 0,
-    DataBlockAllocator*                db_allocator_ = 0
+    DataBlockAllocator*                db_allocator_ = 0,
+    DataBlockCopies*                   copies = 0
   );
 
   /// Copy constructor.
@@ -14,7 +14,8 @@ OpenDDS::DCPS::TransportRetainedElement::TransportRetainedElement(
     const ACE_Message_Block*           message,
     const RepoId&                      pubId,
     MessageBlockAllocator*             mb_allocator,
-    DataBlockAllocator*                db_allocator
+    DataBlockAllocator*                db_allocator,
+    DataBlockCopies*                   copies
 ) : TransportQueueElement(1),
     publication_id_( pubId),
     mb_allocator_( mb_allocator),
@@ -23,7 +24,8 @@ OpenDDS::DCPS::TransportRetainedElement::TransportRetainedElement(
   if (message != 0) {
     msg_.reset(TransportQueueElement::clone_mb(message,
                                            this->mb_allocator_,
-                                           this->db_allocator_));
+                                           this->db_allocator_,
+                                           copies));
   }
 }
 
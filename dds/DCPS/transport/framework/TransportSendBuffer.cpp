@@ -230,20 +230,26 @@ SingleSendBuffer::insert_buffer(BufferType& buffer,
                                 TransportSendStrategy::QueueType* queue,
                                 ACE_Message_Block* chain)
 {
+  // The packet chain references the data blocks of the elements, each
+  // of them is copied once and shared by the elements and the packet.
+  TransportQueueElement::DataBlockCopies copies;
+
   // Copy sample's TransportQueueElements:
   TransportSendStrategy::QueueType*& elems = buffer.first;
   ACE_NEW(elems, TransportSendStrategy::QueueType());
 
   CopyChainVisitor visitor(*elems,
                            &this->retained_mb_allocator_,
-                           &this->retained_db_allocator_);
+                           &this->retained_db_allocator_,
+                           &copies);
   queue->accept_visitor(visitor);
 
   // Copy sample's message/data block descriptors:
   ACE_Message_Block*& data = buffer.second;
   data = TransportQueueElement::clone_mb(chain,
                                          &this->retained_mb_allocator_,
-                                         &this->retained_db_allocator_);
+                                         &this->retained_db_allocator_,
+                                         &copies);
 }
 
 void
@@ -22,6 +22,7 @@
 #include "dds/DCPS/transport/framework/ReceivedDataSample.h"
 #include "dds/DCPS/transport/framework/TransportSendListener.h"
 
+#include <algorithm>
 #include <cstring>
 
 #ifndef __ACE_INLINE__
@@ -33,6 +34,25 @@ namespace {
     STATUS_INFO_DISPOSE = { { 0, 0, 0, 1 } },
     STATUS_INFO_UNREGISTER = { { 0, 0, 0, 2 } },
     STATUS_INFO_DISPOSE_UNREGISTER = { { 0, 0, 0, 3 } };
+
+  /// Copy the n octets found at offset in the chain of mb to dest, without
+  /// moving its read pointers.
+  bool peek(const ACE_Message_Block* mb, size_t offset, char* dest, size_t n)
+  {
+    for (; mb && n; mb = mb->cont()) {
+      const size_t len = mb->length();
+      if (offset >= len) {
+        offset -= len;
+        continue;
+      }
+      const size_t chunk = (std::min)(len - offset, n);
+      std::memcpy(dest, mb->rd_ptr() + offset, chunk);
+      dest += chunk;
+      n -= chunk;
+      offset = 0;
+    }
+    return n == 0;
+  }
 }
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -86,6 +106,36 @@ RtpsSampleHeader::init(ACE_Message_Block& mb)
 
   ACE_CDR::UShort octetsToNextHeader = 0;
 
+  if (data_filter_ && (kind == DATA || kind == DATA_FRAG)) {
+    // The writerId follows the SubmessageHeader, extraFlags,
+    // octetsToInlineQos and readerId, its octets don't depend on the
+    // byte order.
+    ACE_CDR::Octet id[4];
+    if (peek(&mb, SMHDR_SZ + 8, reinterpret_cast<char*>(id), sizeof id)) {
+      EntityId_t writer_id;
+      std::memcpy(writer_id.entityKey, id, sizeof writer_id.entityKey);
+      writer_id.entityKind = id[3];
+
+      if (!data_filter_->accept_data(writer_id)) {
+        SubmessageHeader submessage;
+        if (!(ser >> submessage)) {
+          return;
+        }
+        submessage_.unknown_sm(submessage);
+        octetsToNextHeader = submessage.submessageLength;
+        if (octetsToNextHeader == 0) {
+          // extends to the end of the Message, as below
+          octetsToNextHeader =
+            static_cast<ACE_CDR::UShort>(message_length_ - SMHDR_SZ);
+        }
+        message_length_ = 0;
+        marshaled_size_ = octetsToNextHeader + SMHDR_SZ;
+        valid_ = ser.skip(octetsToNextHeader);
+        return;
+      }
+    }
+  }
+
 #define CASE_SMKIND(kind, class, name) case kind: {               \
     class submessage;                                             \
     if (ser >> submessage) {                                      \
@@ -54,6 +54,18 @@ public:
   explicit RtpsSampleHeader(ACE_Message_Block& mb);
   RtpsSampleHeader& operator=(ACE_Message_Block& mn);
 
+  /// Consulted by init() with the writerId of each DATA and DATA_FRAG
+  /// Submessage, before the rest of it (including any inline QoS) is
+  /// deserialized.  A rejected Submessage is skipped as if it was of an
+  /// unknown kind.
+  class DataFilter {
+  public:
+    virtual ~DataFilter() {}
+    virtual bool accept_data(const EntityId_t& writer_id) = 0;
+  };
+
+  void data_filter(DataFilter* filter);
+
   void pdu_remaining(size_t size);
   size_t marshaled_size();
   ACE_UINT32 message_length();
@@ -73,6 +85,7 @@ private:
 
   bool valid_, frag_;
   size_t marshaled_size_, message_length_;
+  DataFilter* data_filter_;
 
 public:
   // Unlike the rest of this class, which is used with the
@@ -16,6 +16,7 @@ RtpsSampleHeader::RtpsSampleHeader()
   , frag_(false)
   , marshaled_size_(0)
   , message_length_(0)
+  , data_filter_(0)
 {
 }
 
@@ -25,6 +26,7 @@ RtpsSampleHeader::RtpsSampleHeader(ACE_Message_Block& mb)
   , frag_(false)
   , marshaled_size_(0)
   , message_length_(0)
+  , data_filter_(0)
 {
   init(mb);
 }
@@ -40,6 +42,12 @@ RtpsSampleHeader::operator=(ACE_Message_Block& mb)
   return *this;
 }
 
+ACE_INLINE void
+RtpsSampleHeader::data_filter(DataFilter* filter)
+{
+  data_filter_ = filter;
+}
+
 ACE_INLINE bool
 RtpsSampleHeader::valid() const
 {
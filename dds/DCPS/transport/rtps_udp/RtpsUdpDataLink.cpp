@@ -42,6 +42,15 @@
 
 namespace {
 
+/// A remote endpoint nothing was heard from for this many heartbeat periods
+/// is considered gone.
+const int ACTIVITY_TIMEOUT_PERIODS = 10;
+
+/// Heartbeats of an acknowledged writer are never spaced out by more than
+/// this many heartbeat periods, so a reader still hears from the writer
+/// well within ACTIVITY_TIMEOUT_PERIODS.
+const size_t MAX_HEARTBEAT_BACKOFF = ACTIVITY_TIMEOUT_PERIODS / 2;
+
 /// Return the number of CORBA::Longs required for the bitmap representation of
 /// sequence numbers between low and high, inclusive (maximum 8 longs).
 CORBA::ULong
@@ -173,6 +182,36 @@ void RtpsUdpDataLink::do_remove_sample(const RepoId& pub_id,
   }
 }
 
+bool
+RtpsUdpDataLink::join_multicast_group(const ACE_INET_Addr& group)
+{
+  const OPENDDS_STRING& net_if = config().multicast_interface_;
+  if (multicast_socket_.join(group, 1,
+                             net_if.empty() ? 0 :
+                             ACE_TEXT_CHAR_TO_TCHAR(net_if.c_str())) != 0) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("(%P|%t) ERROR: ")
+                      ACE_TEXT("RtpsUdpDataLink::join_multicast_group: ")
+                      ACE_TEXT("ACE_SOCK_Dgram_Mcast::join failed: %m\n")),
+                     false);
+  }
+  return true;
+}
+
+void
+RtpsUdpDataLink::leave_multicast_group(const ACE_INET_Addr& group)
+{
+  const OPENDDS_STRING& net_if = config().multicast_interface_;
+  if (multicast_socket_.leave(group,
+                              net_if.empty() ? 0 :
+                              ACE_TEXT_CHAR_TO_TCHAR(net_if.c_str())) != 0) {
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: ")
+               ACE_TEXT("RtpsUdpDataLink::leave_multicast_group: ")
+               ACE_TEXT("ACE_SOCK_Dgram_Mcast::leave failed: %m\n")));
+  }
+}
+
 bool
 RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket)
 {
@@ -181,20 +220,34 @@ RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket)
   RtpsUdpInst& config = this->config();
 
   if (config.use_multicast_) {
-    const OPENDDS_STRING& net_if = config.multicast_interface_;
+    // A socket bound to the group address only receives that group, the
+    // topic groups are joined on the same socket.
+    bool bind_any = config.topic_multicast_group_count_
+      || !config.topic_multicast_groups_.empty();
 #ifdef ACE_HAS_MAC_OSX
-    multicast_socket_.opts(ACE_SOCK_Dgram_Mcast::OPT_BINDADDR_NO |
-                           ACE_SOCK_Dgram_Mcast::DEFOPT_NULLIFACE);
+    bind_any = true;
 #endif
-    if (multicast_socket_.join(config.multicast_group_address_, 1,
-                               net_if.empty() ? 0 :
-                               ACE_TEXT_CHAR_TO_TCHAR(net_if.c_str())) != 0) {
-      ACE_ERROR_RETURN((LM_ERROR,
-                        ACE_TEXT("(%P|%t) ERROR: ")
-                        ACE_TEXT("RtpsUdpDataLink::open: ")
-                        ACE_TEXT("ACE_SOCK_Dgram_Mcast::join failed: %m\n")),
-                       false);
+    if (bind_any) {
+      multicast_socket_.opts(ACE_SOCK_Dgram_Mcast::OPT_BINDADDR_NO |
+                             ACE_SOCK_Dgram_Mcast::DEFOPT_NULLIFACE);
+    }
+    if (!join_multicast_group(config.multicast_group_address_)) {
+      return false;
+    }
+#ifdef IP_MULTICAST_ALL
+    // A socket bound to the wildcard address otherwise also receives the
+    // groups joined by any other socket on the port (Linux).  IPv6 sockets
+    // have no such option before Linux 4.20 and still do.
+    if (bind_any && multicast_socket_.get_handle() != ACE_INVALID_HANDLE) {
+      int all = 0;
+      if (multicast_socket_.set_option(IPPROTO_IP, IP_MULTICAST_ALL,
+                                       &all, sizeof all) != 0) {
+        ACE_ERROR((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: RtpsUdpDataLink::open: ")
+                   ACE_TEXT("failed to clear IP_MULTICAST_ALL: %m\n")));
+      }
     }
+#endif
   }
 
   if (!OpenDDS::DCPS::set_socket_multicast_ttl(unicast_socket_, config.ttl_)) {
@@ -309,6 +362,11 @@ RtpsUdpDataLink::associated(const RepoId& local_id, const RepoId& remote_id,
     relay_beacon_->schedule_enable(false);
   }
 
+  if (conv.isReader()) {
+    ACE_GUARD(ACE_Thread_Mutex, g, matched_writers_lock_);
+    matched_writers_[remote_id].insert(local_id);
+  }
+
   if (!local_reliable) {
     return;
   }
@@ -341,6 +399,25 @@ RtpsUdpDataLink::associated(const RepoId& local_id, const RepoId& remote_id,
   }
 }
 
+bool
+RtpsUdpDataLink::is_matched_writer(const RepoId& writer) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, matched_writers_lock_, false);
+  return matched_writers_.find(writer) != matched_writers_.end();
+}
+
+size_t
+RtpsUdpDataLink::held_bytes(const RepoId& reader, const RepoId& writer) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+  const RtpsReaderMap::const_iterator rr = readers_.find(reader);
+  if (rr == readers_.end()) {
+    return 0;
+  }
+  const WriterInfoMap::const_iterator wi = rr->second.remote_writers_.find(writer);
+  return wi == rr->second.remote_writers_.end() ? 0 : wi->second.held_bytes_;
+}
+
 bool
 RtpsUdpDataLink::check_handshake_complete(const RepoId& local_id,
                                           const RepoId& remote_id)
@@ -509,9 +586,21 @@ RtpsUdpDataLink::release_reservations_i(const RepoId& remote_id,
 {
   OPENDDS_VECTOR(TransportQueueElement*) to_deliver;
   OPENDDS_VECTOR(TransportQueueElement*) to_drop;
-  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
   using std::pair;
   const GuidConverter conv(local_id);
+
+  if (conv.isReader()) {
+    ACE_GUARD(ACE_Thread_Mutex, g, matched_writers_lock_);
+    const MatchedWriterMap::iterator mw = matched_writers_.find(remote_id);
+    if (mw != matched_writers_.end()) {
+      mw->second.erase(local_id);
+      if (mw->second.empty()) {
+        matched_writers_.erase(mw);
+      }
+    }
+  }
+
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
   if (conv.isWriter()) {
     const RtpsWriterMap::iterator rw = writers_.find(local_id);
 
@@ -689,6 +778,38 @@ namespace {
     }
     return hdr;
   }
+
+  // Durable data may share an RTPS Message with other samples when it is
+  // replayed, so its DATA Submessage can't extend to the end of the Message.
+  // The payload is padded so that the following Submessage stays aligned.
+  void set_data_length(RTPS::SubmessageSeq& subm, ACE_Message_Block* data)
+  {
+    const CORBA::ULong n = subm.length();
+    if (!n || !data || subm[n - 1]._d() != RTPS::DATA) {
+      return;
+    }
+
+    RTPS::DataSubmessage& sm = subm[n - 1].data_sm();
+    size_t size = 0, padding = 0;
+    gen_find_size(sm, size, padding);
+    const size_t len = size + padding - RTPS::SMHDR_SZ + data->total_length();
+    const size_t pad = len % 4 ? 4 - (len % 4) : 0;
+    if (len + pad > 0xFFFF) {
+      return; // must be sent in a Message of its own
+    }
+    sm.smHeader.submessageLength = static_cast<CORBA::UShort>(len + pad);
+
+    if (pad) {
+      ACE_Message_Block* tail = data;
+      while (tail->cont()) {
+        tail = tail->cont();
+      }
+      ACE_Message_Block* pad_mb = new ACE_Message_Block(pad);
+      std::memset(pad_mb->wr_ptr(), 0, pad);
+      pad_mb->wr_ptr(pad);
+      tail->cont(pad_mb);
+    }
+  }
 }
 
 TransportQueueElement*
@@ -800,6 +921,10 @@ RtpsUdpDataLink::customize_queue_element(TransportQueueElement* element)
   }
 #endif
 
+  if (durable) {
+    set_data_length(subm, data.get());
+  }
+
   Message_Block_Ptr hdr(submsgs_to_msgblock(subm));
   hdr->cont(data.release());
   RtpsCustomizedElement* rtps =
@@ -1035,7 +1160,54 @@ RtpsUdpDataLink::process_data_i(const RTPS::DataSubmessage& data,
       }
       const ReceivedDataSample* sample =
         receive_strategy()->withhold_data_from(readerId);
-      info.held_.insert(std::make_pair(seq, *sample));
+      const size_t bytes =
+        sample->sample_ ? sample->sample_->total_length() : 0;
+      const size_t max_held = config().max_held_bytes_;
+      // Make room by evicting the highest held samples after seq.  Every
+      // held sample is after cumulative_ack() + 1, so that sample, or
+      // any other before the lowest held one, is always taken and
+      // delivery keeps advancing.  Evicted samples are no longer recorded
+      // as received, the writer will be asked for them again.
+      while (max_held && !info.held_.empty()
+             && info.held_bytes_ + bytes > max_held
+             && seq < info.held_.rbegin()->first) {
+        const OPENDDS_MAP(SequenceNumber, ReceivedDataSample)::iterator last =
+          --info.held_.end();
+        if (Transport_debug_level) {
+          GuidConverter writer(src);
+          GuidConverter reader(readerId);
+          ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: RtpsUdpDataLink::process_data_i(DataSubmessage) -")
+                                 ACE_TEXT(" held data seq: %q from %C evicted for %C to hold seq: %q\n"),
+                                 last->first.getValue(),
+                                 OPENDDS_STRING(writer).c_str(),
+                                 OPENDDS_STRING(reader).c_str(),
+                                 seq.getValue()));
+        }
+        const size_t last_bytes =
+          last->second.sample_ ? last->second.sample_->total_length() : 0;
+        info.held_bytes_ -= std::min(last_bytes, info.held_bytes_);
+        info.recvd_.erase(last->first);
+        info.held_.erase(last);
+      }
+      if (max_held && !info.held_.empty()
+          && info.held_bytes_ + bytes > max_held) {
+        // Not recorded as received: the writer will be asked again once
+        // the held samples before it are delivered.
+        if (Transport_debug_level) {
+          GuidConverter writer(src);
+          GuidConverter reader(readerId);
+          ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: RtpsUdpDataLink::process_data_i(DataSubmessage) -")
+                                 ACE_TEXT(" data seq: %q from %C dropped for %C, %B bytes already held\n"),
+                                 seq.getValue(),
+                                 OPENDDS_STRING(writer).c_str(),
+                                 OPENDDS_STRING(reader).c_str(),
+                                 info.held_bytes_));
+        }
+        return false;
+      }
+      if (info.held_.insert(std::make_pair(seq, *sample)).second) {
+        info.held_bytes_ += bytes;
+      }
     } else {
       if (Transport_debug_level > 5) {
         GuidConverter writer(src);
@@ -1282,7 +1454,8 @@ RtpsUdpDataLink::RtpsReader::nack_durable(const WriterInfo& info)
 }
 
 void
-RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag)
+RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag,
+                                SubmessageBundles* bundles)
 {
   using namespace OpenDDS::RTPS;
 
@@ -1423,9 +1596,9 @@ RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag)
       OPENDDS_VECTOR(NackFragSubmessage) nack_frags;
       size += generate_nack_frags(nack_frags, wi->second, wi->first);
 
-      ACE_Message_Block mb_acknack(size + padding); //FUTURE: allocators?
+      Message_Block_Ptr mb_acknack(new ACE_Message_Block(size + padding)); //FUTURE: allocators?
       // byte swapping is handled in the operator<<() implementation
-      Serializer ser(&mb_acknack, false, Serializer::ALIGN_CDR);
+      Serializer ser(mb_acknack.get(), false, Serializer::ALIGN_CDR);
       std::memcpy(info_dst.guidPrefix, wi->first.guidPrefix,
                   sizeof(GuidPrefix_t));
       ser << info_dst;
@@ -1446,20 +1619,63 @@ RtpsUdpDataLink::send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag)
                      "(%P|%t) RtpsUdpDataLink::send_heartbeat_replies() - "
                      "no locator for remote %C\n", OPENDDS_STRING(conv).c_str()));
         }
+      } else if (bundles) {
+        (*bundles)[iter->second.addr_].push_back(mb_acknack.release());
       } else {
-        send_strategy()->send_rtps_control(mb_acknack,
+        send_strategy()->send_rtps_control(*mb_acknack,
                                            iter->second.addr_);
       }
     }
   }
 }
 
+void
+RtpsUdpDataLink::send_bundles(SubmessageBundles& bundles)
+{
+  // Each bundle entry is one Message Block starting with an INFO_DST, so
+  // consecutive entries form a valid RTPS Message when chained.
+  const size_t max_bytes =
+    send_strategy()->max_message_size() - RTPS::RTPSHDR_SZ;
+  const size_t max_blocks = MAX_SEND_BLOCKS - 1; // the RTPS Header uses one
+#ifdef OPENDDS_SECURITY
+  // RTPS and Submessage protection grow the Message, keep one each.
+  const bool combine = local_crypto_handle() == DDS::HANDLE_NIL;
+#else
+  const bool combine = true;
+#endif
+
+  for (SubmessageBundles::iterator it = bundles.begin(); it != bundles.end();
+       ++it) {
+    OPENDDS_VECTOR(ACE_Message_Block*)& blocks = it->second;
+    size_t first = 0, bytes = 0;
+    for (size_t i = 0; i <= blocks.size(); ++i) {
+      if (i > first && (i == blocks.size() || !combine
+                        || bytes + blocks[i]->length() > max_bytes
+                        || i - first == max_blocks)) {
+        for (size_t j = first; j + 1 < i; ++j) {
+          blocks[j]->cont(blocks[j + 1]);
+        }
+        send_strategy()->send_rtps_control(*blocks[first], it->first);
+        blocks[first]->release(); // releases the whole chain
+        first = i;
+        bytes = 0;
+      }
+      if (i < blocks.size()) {
+        bytes += blocks[i]->length();
+      }
+    }
+  }
+  bundles.clear();
+}
+
 void
 RtpsUdpDataLink::send_heartbeat_replies() // from DR to DW
 {
   using namespace OpenDDS::RTPS;
   ACE_GUARD(ACE_Thread_Mutex, g, lock_);
 
+  SubmessageBundles bundles;
+
   for (InterestingAckNackSetType::const_iterator pos = interesting_ack_nacks_.begin(),
          limit = interesting_ack_nacks_.end();
        pos != limit;
@@ -1492,9 +1708,10 @@ RtpsUdpDataLink::send_heartbeat_replies() // from DR to DW
     };
     gen_find_size(info_dst, size, padding);
 
-    ACE_Message_Block mb_acknack(size + padding); //FUTURE: allocators?
+    ACE_Message_Block* const mb_acknack =
+      new ACE_Message_Block(size + padding); //FUTURE: allocators?
     // byte swapping is handled in the operator<<() implementation
-    Serializer ser(&mb_acknack, false, Serializer::ALIGN_CDR);
+    Serializer ser(mb_acknack, false, Serializer::ALIGN_CDR);
     std::memcpy(info_dst.guidPrefix, pos->writerid.guidPrefix,
                 sizeof(GuidPrefix_t));
     ser << info_dst;
@@ -1502,14 +1719,18 @@ RtpsUdpDataLink::send_heartbeat_replies() // from DR to DW
     // testing indicated that other DDS implementations didn't accept it.
     ser << acknack;
 
-    send_strategy()->send_rtps_control(mb_acknack, pos->writer_address);
+    bundles[pos->writer_address].push_back(mb_acknack);
   }
   interesting_ack_nacks_.clear();
 
   for (RtpsReaderMap::iterator rr = readers_.begin(); rr != readers_.end();
        ++rr) {
-    send_ack_nacks(*rr);
+    send_ack_nacks(*rr, false, &bundles);
   }
+
+  // ACKNACKs of all local readers to the same remote participant share
+  // RTPS Messages instead of each taking one.
+  send_bundles(bundles);
 }
 
 size_t
@@ -1789,6 +2010,7 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
         lastSent = requests.low().previous();
       }
       DisjointSequence gaps;
+      OPENDDS_VECTOR(TransportQueueElement*) to_resend;
       for (size_t i = 0; i < psr.size(); ++i) {
         for (; it != ri->second.durable_data_.end()
              && it->first < psr[i].first; ++it) ; // empty for-loop
@@ -1798,8 +2020,7 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
             ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::received(ACKNACK) "
                        "durable resend %d\n", int(it->first.getValue())));
           }
-          durability_resend(it->second);
-          //FUTURE: combine multiple resends into one RTPS Message?
+          to_resend.push_back(it->second);
           sent_some = true;
           if (it->first > lastSent + 1) {
             gaps.insert(SequenceRange(lastSent + 1, it->first.previous()));
@@ -1813,6 +2034,7 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
           }
         }
       }
+      durability_resend(to_resend, get_locator(remote));
       if (!gaps.empty()) {
         if (Transport_debug_level > 5) {
           ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::received(ACKNACK) "
@@ -1947,6 +2169,7 @@ RtpsUdpDataLink::send_nack_replies()
     // consolidate requests from N readers
     OPENDDS_SET(ACE_INET_Addr) recipients;
     DisjointSequence requests;
+    RequestsByAddr requests_by_addr;
     RtpsWriter& writer = rw->second;
 
     //track if any messages have been fully acked by all readers
@@ -1974,12 +2197,22 @@ RtpsUdpDataLink::send_nack_replies()
       }
 #endif
 
-      process_requested_changes(requests, writer, ri->second);
+      DisjointSequence reader_requests;
+      process_requested_changes(reader_requests, writer, ri->second);
+      const OPENDDS_VECTOR(SequenceRange) reader_ranges =
+        reader_requests.present_sequence_ranges();
+      for (size_t i = 0; i < reader_ranges.size(); ++i) {
+        requests.insert(reader_ranges[i]);
+      }
 
       if (!ri->second.requested_changes_.empty()) {
         const OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter = locators_.find(ri->first);
         if (iter != locators_.end()) {
           recipients.insert(iter->second.addr_);
+          DisjointSequence& addr_requests = requests_by_addr[iter->second.addr_];
+          for (size_t i = 0; i < reader_ranges.size(); ++i) {
+            addr_requests.insert(reader_ranges[i]);
+          }
           if (Transport_debug_level > 5) {
             const GuidConverter local_conv(rw->first), remote_conv(ri->first);
             ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::send_nack_replies "
@@ -1997,19 +2230,7 @@ RtpsUdpDataLink::send_nack_replies()
       if (writer.send_buff_.is_nil() || writer.send_buff_->empty()) {
         gaps = requests;
       } else {
-        OPENDDS_VECTOR(SequenceRange) ranges = requests.present_sequence_ranges();
-        SingleSendBuffer& sb = *writer.send_buff_;
-        ACE_GUARD(TransportSendBuffer::LockType, guard, sb.strategy_lock());
-        const RtpsUdpSendStrategy::OverrideToken ot =
-          send_strategy()->override_destinations(recipients);
-        for (size_t i = 0; i < ranges.size(); ++i) {
-          if (Transport_debug_level > 5) {
-            ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::send_nack_replies "
-                       "resend data %d-%d\n", int(ranges[i].first.getValue()),
-                       int(ranges[i].second.getValue())));
-          }
-          sb.resend_i(ranges[i], &gaps);
-        }
+        resend_requested(writer, requests, requests_by_addr, gaps);
       }
     }
 
@@ -2034,6 +2255,102 @@ RtpsUdpDataLink::send_nack_replies()
   }
 }
 
+void
+RtpsUdpDataLink::resend_requested(RtpsWriter& writer,
+                                  const DisjointSequence& requests,
+                                  const RequestsByAddr& requests_by_addr,
+                                  DisjointSequence& gaps)
+{
+  // Plan the repairs: each sample goes to the readers that requested it, or
+  // once to the multicast group when enough of them did.  The requests are
+  // split where any address's requests begin or end, all the samples of a
+  // piece have the same destinations and are resent together.
+  const RtpsUdpInst& config = this->config();
+  const bool use_group = config.use_multicast_
+    && config.repair_multicast_threshold_ > 0;
+
+  typedef OPENDDS_SET(SequenceNumber) BoundarySet;
+  BoundarySet bounds;
+  for (RequestsByAddr::const_iterator it = requests_by_addr.begin();
+       it != requests_by_addr.end(); ++it) {
+    const OPENDDS_VECTOR(SequenceRange) addr_ranges =
+      it->second.present_sequence_ranges();
+    for (size_t i = 0; i < addr_ranges.size(); ++i) {
+      SequenceNumber after = addr_ranges[i].second;
+      bounds.insert(addr_ranges[i].first);
+      bounds.insert(++after);
+    }
+  }
+
+  typedef OPENDDS_SET(ACE_INET_Addr) AddrSet;
+  typedef std::pair<SequenceRange, AddrSet> Repair;
+  OPENDDS_VECTOR(Repair) plan;
+
+  const OPENDDS_VECTOR(SequenceRange) ranges =
+    requests.present_sequence_ranges();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    SequenceNumber after_range = ranges[i].second;
+    bounds.insert(++after_range);
+
+    SequenceNumber first = ranges[i].first;
+    while (first <= ranges[i].second) {
+      const SequenceNumber next = *bounds.upper_bound(first);
+      const SequenceRange piece(first, next.previous());
+      first = next;
+
+      AddrSet dests;
+      for (RequestsByAddr::const_iterator it = requests_by_addr.begin();
+           it != requests_by_addr.end(); ++it) {
+        if (it->second.contains(piece.first)) {
+          dests.insert(it->first);
+        }
+      }
+      if (dests.empty()) {
+        continue;
+      }
+      if (use_group && dests.size() >= config.repair_multicast_threshold_) {
+        dests.clear();
+        dests.insert(config.multicast_group_address_);
+      }
+      if (!plan.empty() && plan.back().first.second == piece.first.previous()
+          && plan.back().second == dests) {
+        plan.back().first.second = piece.second;
+      } else {
+        plan.push_back(Repair(piece, dests));
+      }
+    }
+  }
+
+  size_t budget = config.max_repair_samples_;
+  SingleSendBuffer& sb = *writer.send_buff_;
+  ACE_GUARD(TransportSendBuffer::LockType, guard, sb.strategy_lock());
+  for (size_t i = 0; i < plan.size(); ++i) {
+    SequenceRange range = plan[i].first;
+    if (config.max_repair_samples_) {
+      if (budget == 0) {
+        break;
+      }
+      const size_t count =
+        size_t(range.second.getValue() - range.first.getValue() + 1);
+      if (count > budget) {
+        range.second =
+          range.first.getValue() + SequenceNumber::Value(budget) - 1;
+      }
+      budget -= std::min(count, budget);
+    }
+
+    if (Transport_debug_level > 5) {
+      ACE_DEBUG((LM_DEBUG, "RtpsUdpDataLink::resend_requested "
+                 "resend data %d-%d to %B destination(s)\n",
+                 int(range.first.getValue()), int(range.second.getValue()),
+                 plan[i].second.size()));
+    }
+    const RtpsUdpSendStrategy::OverrideToken ot =
+      send_strategy()->override_destinations(plan[i].second);
+    sb.resend_i(range, &gaps);
+  }
+}
+
 void
 RtpsUdpDataLink::send_nackfrag_replies(RtpsWriter& writer,
                                        DisjointSequence& gaps,
@@ -2342,11 +2659,56 @@ RtpsUdpDataLink::marshal_gaps(const RepoId& writer, const RepoId& reader,
 }
 
 void
-RtpsUdpDataLink::durability_resend(TransportQueueElement* element)
-{
-  ACE_Message_Block* msg = const_cast<ACE_Message_Block*>(element->msg());
-  send_strategy()->send_rtps_control(*msg,
-                                    get_locator(element->subscription_id()));
+RtpsUdpDataLink::durability_resend(
+  const OPENDDS_VECTOR(TransportQueueElement*)& elements,
+  const ACE_INET_Addr& addr)
+{
+  // Replay as many durable samples per RTPS Message as the UDP datagram and
+  // the gather-write (iovec) limit allow, instead of one Message per sample.
+  const size_t max_bytes =
+    send_strategy()->max_message_size() - RTPS::RTPSHDR_SZ;
+  const size_t max_blocks = MAX_SEND_BLOCKS - 1; // the RTPS Header uses one
+#ifdef OPENDDS_SECURITY
+  // RTPS and Submessage protection grow the Message, keep one sample each.
+  const bool combine = local_crypto_handle() == DDS::HANDLE_NIL;
+#else
+  const bool combine = true;
+#endif
+
+  Message_Block_Ptr head;
+  ACE_Message_Block* tail = 0;
+  size_t bytes = 0, blocks = 0;
+
+  for (size_t i = 0; i < elements.size(); ++i) {
+    const ACE_Message_Block* msg = elements[i]->msg();
+    size_t msg_blocks = 0;
+    for (const ACE_Message_Block* mb = msg; mb; mb = mb->cont()) {
+      ++msg_blocks;
+    }
+    const size_t msg_bytes = msg->total_length();
+
+    if (head && (!combine || bytes + msg_bytes > max_bytes
+                 || blocks + msg_blocks > max_blocks)) {
+      send_strategy()->send_rtps_control(*head, addr);
+      head.reset();
+      tail = 0;
+      bytes = blocks = 0;
+    }
+
+    ACE_Message_Block* const dup = msg->duplicate();
+    if (tail) {
+      tail->cont(dup);
+    } else {
+      head.reset(dup);
+    }
+    for (tail = dup; tail->cont(); tail = tail->cont()) ; // empty for-loop
+    bytes += msg_bytes;
+    blocks += msg_blocks;
+  }
+
+  if (head) {
+    send_strategy()->send_rtps_control(*head, addr);
+  }
 }
 
 void
@@ -2389,7 +2751,8 @@ RtpsUdpDataLink::send_heartbeats()
 
     RtpsUdpInst& config = this->config();
 
-    const ACE_Time_Value tv = now - 10 * config.heartbeat_period_;
+    const ACE_Time_Value tv =
+      now - ACTIVITY_TIMEOUT_PERIODS * config.heartbeat_period_;
     const ACE_Time_Value tv3 = now - 3 * config.heartbeat_period_;
     for (InterestingRemoteMapType::iterator pos = interesting_readers_.begin(),
            limit = interesting_readers_.end();
@@ -2414,6 +2777,8 @@ RtpsUdpDataLink::send_heartbeats()
                             && !rw->second.send_buff_->empty();
       bool final = true, has_durable_data = false;
       SequenceNumber durable_max = SequenceNumber::ZERO();
+      // Only added to recipients if the heartbeat is not skipped below
+      OPENDDS_SET(ACE_INET_Addr) writer_recipients;
 
       typedef ReaderInfoMap::iterator ri_iter;
       const ri_iter end = rw->second.remote_readers_.end();
@@ -2421,7 +2786,7 @@ RtpsUdpDataLink::send_heartbeats()
         if (has_data || !ri->second.handshake_done_) {
           const OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter = locators_.find(ri->first);
           if (iter != locators_.end()) {
-            recipients.insert(iter->second.addr_);
+            writer_recipients.insert(iter->second.addr_);
             if (final && !ri->second.handshake_done_) {
               final = false;
             }
@@ -2451,7 +2816,7 @@ RtpsUdpDataLink::send_heartbeats()
             }
             const OPENDDS_MAP_CMP(RepoId, RemoteInfo, GUID_tKeyLessThan)::const_iterator iter = locators_.find(ri->first);
             if (iter != locators_.end()) {
-              recipients.insert(iter->second.addr_);
+              writer_recipients.insert(iter->second.addr_);
             }
           }
         }
@@ -2474,6 +2839,29 @@ RtpsUdpDataLink::send_heartbeats()
         continue;
       }
 
+      // Once all readers acknowledged everything, the heartbeat only tells
+      // them nothing changed: send it less and less often.
+      bool acked_by_all = final && !has_durable_data && has_data;
+      for (ri_iter ri = rw->second.remote_readers_.begin();
+           acked_by_all && ri != end; ++ri) {
+        acked_by_all =
+          ri->second.cur_cumulative_ack_ > rw->second.send_buff_->high();
+      }
+      if (acked_by_all) {
+        if (++rw->second.heartbeats_skipped_ < rw->second.heartbeat_backoff_) {
+          continue;
+        }
+        rw->second.heartbeats_skipped_ = 0;
+        rw->second.heartbeat_backoff_ =
+          std::min(2 * rw->second.heartbeat_backoff_,
+                   std::min(std::max(config.max_heartbeat_backoff_, size_t(1)),
+                            MAX_HEARTBEAT_BACKOFF));
+      } else {
+        rw->second.heartbeat_backoff_ = 1;
+        rw->second.heartbeats_skipped_ = 0;
+      }
+      recipients.insert(writer_recipients.begin(), writer_recipients.end());
+
       const SequenceNumber firstSN = (rw->second.durable_ || !has_data)
                                      ? 1 : rw->second.send_buff_->low(),
           lastSN = std::max(durable_max, has_data ? rw->second.send_buff_->high() : SequenceNumber::ZERO());
@@ -2598,7 +2986,8 @@ RtpsUdpDataLink::check_heartbeats()
   OPENDDS_VECTOR(CallbackType) writerDoesNotExistCallbacks;
 
   // Have any interesting writers timed out?
-  const ACE_Time_Value tv = ACE_OS::gettimeofday() - 10 * this->config().heartbeat_period_;
+  const ACE_Time_Value tv = ACE_OS::gettimeofday()
+    - ACTIVITY_TIMEOUT_PERIODS * this->config().heartbeat_period_;
   {
     ACE_GUARD(ACE_Thread_Mutex, g, lock_);
 
@@ -2831,6 +3220,9 @@ void
 RtpsUdpDataLink::RtpsWriter::add_elem_awaiting_ack(TransportQueueElement* element)
 {
   elems_not_acked_.insert(SnToTqeMap::value_type(element->sequence(), element));
+  // new data, heartbeat on the next period again
+  heartbeat_backoff_ = 1;
+  heartbeats_skipped_ = 0;
 }
 
 
@@ -2931,6 +3323,9 @@ void RtpsUdpDataLink::HeldDataDeliveryHandler::notify_delivery(const RepoId& rea
     }
     // The head_data_ is not protected by a mutex because it is always accessed from the reactor task thread.
     held_data_.push_back(HeldDataEntry(it->second, readerId));
+    const size_t bytes =
+      it->second.sample_ ? it->second.sample_->total_length() : 0;
+    info.held_bytes_ -= std::min(bytes, info.held_bytes_);
     info.held_.erase(it++);
   }
   link_->reactor_task_->get_reactor()->notify(this);
@@ -76,6 +76,13 @@ public:
 
   bool open(const ACE_SOCK_Dgram& unicast_socket);
 
+  /// Also receive on the multicast socket what is sent to group, which
+  /// has the port of the config's multicast_group_address_.
+  bool join_multicast_group(const ACE_INET_Addr& group);
+
+  /// Stop receiving what is sent to a group joined by join_multicast_group().
+  void leave_multicast_group(const ACE_INET_Addr& group);
+
   void received(const RTPS::DataSubmessage& data,
                 const GuidPrefix_t& src_prefix);
 
@@ -110,6 +117,14 @@ public:
                   bool local_reliable, bool remote_reliable,
                   bool local_durable, bool remote_durable);
 
+  /// Is a local DataReader associated with the remote writer?  Used by the
+  /// receive strategy to skip the submessages of any other writer.
+  bool is_matched_writer(const RepoId& writer) const;
+
+  /// Bytes of the out-of-order samples of the remote writer held for the
+  /// local reader, see RtpsUdpInst::max_held_bytes_.
+  size_t held_bytes(const RepoId& reader, const RepoId& writer) const;
+
   bool check_handshake_complete(const RepoId& local, const RepoId& remote);
 
   void register_for_reader(const RepoId& writerid,
@@ -240,8 +255,13 @@ private:
     SnToTqeMap to_deliver_;
     bool durable_;
     bool ready_to_hb_;
+    /// Heartbeat periods between heartbeats while acked by all readers,
+    /// and the periods skipped since the last one.
+    size_t heartbeat_backoff_, heartbeats_skipped_;
 
-    RtpsWriter() : durable_(false), ready_to_hb_(false) {}
+    RtpsWriter()
+      : durable_(false), ready_to_hb_(false)
+      , heartbeat_backoff_(1), heartbeats_skipped_(0) {}
     ~RtpsWriter();
     SequenceNumber heartbeat_high(const ReaderInfo&) const;
     void add_elem_awaiting_ack(TransportQueueElement* element);
@@ -260,6 +280,8 @@ private:
   struct WriterInfo {
     DisjointSequence recvd_;
     OPENDDS_MAP(SequenceNumber, ReceivedDataSample) held_;
+    /// Bytes of the samples in held_.
+    size_t held_bytes_;
     SequenceRange hb_range_;
     OPENDDS_MAP(SequenceNumber, RTPS::FragmentNumber_t) frags_;
     bool ack_pending_, initial_hb_;
@@ -267,7 +289,7 @@ private:
       acknack_count_, nackfrag_count_;
 
     WriterInfo()
-      : ack_pending_(false), initial_hb_(true), heartbeat_recvd_count_(0),
+      : held_bytes_(0), ack_pending_(false), initial_hb_(true), heartbeat_recvd_count_(0),
         hb_frag_recvd_count_(0), acknack_count_(0), nackfrag_count_(0) { hb_range_.second = SequenceNumber::ZERO(); }
 
     bool should_nack() const;
@@ -295,6 +317,13 @@ private:
   /// for adding/removing associations from the DataLink.
   mutable ACE_Thread_Mutex lock_;
 
+  /// The local DataReaders associated with each remote writer, whatever
+  /// their reliability.  It has its own lock since it is consulted for
+  /// each DATA and DATA_FRAG submessage received.
+  typedef OPENDDS_MAP_CMP(RepoId, RepoIdSet, GUID_tKeyLessThan) MatchedWriterMap;
+  MatchedWriterMap matched_writers_;
+  mutable ACE_Thread_Mutex matched_writers_lock_;
+
   size_t generate_nack_frags(OPENDDS_VECTOR(RTPS::NackFragSubmessage)& nack_frags,
                              WriterInfo& wi, const RepoId& pub_id);
 
@@ -319,7 +348,8 @@ private:
   bool process_data_i(const RTPS::DataSubmessage& data, const RepoId& src,
                       RtpsReaderMap::value_type& rr);
 
-  void durability_resend(TransportQueueElement* element);
+  void durability_resend(const OPENDDS_VECTOR(TransportQueueElement*)& elements,
+                         const ACE_INET_Addr& addr);
   void send_durability_gaps(const RepoId& writer, const RepoId& reader,
                             const DisjointSequence& gaps);
   ACE_Message_Block* marshal_gaps(const RepoId& writer, const RepoId& reader,
@@ -367,6 +397,10 @@ private:
   void send_nack_replies();
   void send_directed_nack_replies(const RepoId& writerId, RtpsWriter& writer,
                                   const RepoId& readerId, ReaderInfo& reader);
+  typedef OPENDDS_MAP(ACE_INET_Addr, DisjointSequence) RequestsByAddr;
+  void resend_requested(RtpsWriter& writer, const DisjointSequence& requests,
+                        const RequestsByAddr& requests_by_addr,
+                        DisjointSequence& gaps);
   void process_requested_changes(DisjointSequence& requests,
                                  const RtpsWriter& writer,
                                  const ReaderInfo& reader);
@@ -511,7 +545,13 @@ private:
   typedef OPENDDS_SET(InterestingAckNack) InterestingAckNackSetType;
   InterestingAckNackSetType interesting_ack_nacks_;
 
-  void send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag = false);
+  /// Reader submessages waiting to be sent together, by destination.
+  typedef OPENDDS_MAP(ACE_INET_Addr, OPENDDS_VECTOR(ACE_Message_Block*))
+    SubmessageBundles;
+
+  void send_ack_nacks(RtpsReaderMap::value_type& rr, bool finalFlag = false,
+                      SubmessageBundles* bundles = 0);
+  void send_bundles(SubmessageBundles& bundles);
 
   class HeldDataDeliveryHandler : public RcEventHandler {
   public:
@@ -40,6 +40,12 @@ RtpsUdpInst::RtpsUdpInst(const OPENDDS_STRING& name)
   , heartbeat_response_delay_(0, 500*1000 /*microseconds*/) // default from RTPS
   , handshake_timeout_(30) // default syn_timeout in OpenDDS_Multicast
   , durable_data_timeout_(60)
+  , max_heartbeat_backoff_(1)
+  , repair_multicast_threshold_(0)
+  , max_repair_samples_(0)
+  , max_held_bytes_(0)
+  , shared_reactor_(false)
+  , topic_multicast_group_count_(0)
   , opendds_discovery_guid_(GUID_UNKNOWN)
 {
 }
@@ -96,6 +102,47 @@ RtpsUdpInst::load(ACE_Configuration_Heap& cf,
                         heartbeat_response_delay_);
   GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("handshake_timeout"),
                         handshake_timeout_);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("max_heartbeat_backoff"),
+                   max_heartbeat_backoff_, size_t);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("repair_multicast_threshold"),
+                   repair_multicast_threshold_, size_t);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("max_repair_samples"),
+                   max_repair_samples_, size_t);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("max_held_bytes"),
+                   max_held_bytes_, size_t);
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("shared_reactor"), shared_reactor_, bool);
+
+  // topic_multicast_groups=Topic1@239.255.1.1,Topic2@239.255.1.2
+  OPENDDS_STRING topic_groups_s;
+  GET_CONFIG_STRING_VALUE(cf, sect, ACE_TEXT("topic_multicast_groups"),
+                          topic_groups_s);
+  while (!topic_groups_s.empty()) {
+    const size_t end = topic_groups_s.find(',');
+    const OPENDDS_STRING entry = topic_groups_s.substr(0, end);
+    topic_groups_s.erase(0, end == OPENDDS_STRING::npos ? end : end + 1);
+    const size_t at = entry.rfind('@');
+    if (at == OPENDDS_STRING::npos || at == 0) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: RtpsUdpInst::load: ")
+                        ACE_TEXT("illegal topic_multicast_groups entry (%C)\n"),
+                        entry.c_str()),
+                       -1);
+    }
+    ACE_INET_Addr group(multicast_group_address_.get_port_number(),
+                        entry.substr(at + 1).c_str());
+    if (!group.is_multicast()) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("(%P|%t) ERROR: RtpsUdpInst::load: ")
+                        ACE_TEXT("topic_multicast_groups entry (%C) is not ")
+                        ACE_TEXT("a multicast address\n"),
+                        entry.c_str()),
+                       -1);
+    }
+    topic_multicast_groups_[entry.substr(0, at)] = group;
+  }
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("topic_multicast_group_count"),
+                   topic_multicast_group_count_, size_t);
 
   ACE_TString rtps_relay_address_s;
   GET_CONFIG_TSTRING_VALUE(cf, sect, ACE_TEXT("DataRtpsRelayAddress"),
@@ -142,11 +189,61 @@ RtpsUdpInst::dump_to_str() const
   ret += formatNameForDump("heartbeat_period") + to_dds_string(heartbeat_period_.msec()) + '\n';
   ret += formatNameForDump("heartbeat_response_delay") + to_dds_string(heartbeat_response_delay_.msec()) + '\n';
   ret += formatNameForDump("handshake_timeout") + to_dds_string(handshake_timeout_.msec()) + '\n';
+  ret += formatNameForDump("max_heartbeat_backoff") + to_dds_string(unsigned(max_heartbeat_backoff_)) + '\n';
+  ret += formatNameForDump("repair_multicast_threshold") + to_dds_string(unsigned(repair_multicast_threshold_)) + '\n';
+  ret += formatNameForDump("max_repair_samples") + to_dds_string(unsigned(max_repair_samples_)) + '\n';
+  ret += formatNameForDump("max_held_bytes") + to_dds_string(unsigned(max_held_bytes_)) + '\n';
+  ret += formatNameForDump("shared_reactor") + (shared_reactor_ ? "true" : "false") + '\n';
+  OPENDDS_STRING topic_groups;
+  for (TopicGroups::const_iterator it = topic_multicast_groups_.begin();
+       it != topic_multicast_groups_.end(); ++it) {
+    const char* group = it->second.get_host_addr();
+    topic_groups += (topic_groups.empty() ? "" : ",") + it->first + '@'
+      + (group ? group : "NOT_SUPPORTED");
+  }
+  ret += formatNameForDump("topic_multicast_groups") + topic_groups + '\n';
+  ret += formatNameForDump("topic_multicast_group_count") + to_dds_string(unsigned(topic_multicast_group_count_)) + '\n';
   return ret;
 }
 
+ACE_INET_Addr
+RtpsUdpInst::topic_multicast_group(const OPENDDS_STRING& topic_name) const
+{
+  if (topic_name.empty()) {
+    return multicast_group_address_;
+  }
+
+  const TopicGroups::const_iterator it =
+    topic_multicast_groups_.find(topic_name);
+  if (it != topic_multicast_groups_.end()) {
+    return it->second;
+  }
+
+  if (topic_multicast_group_count_ == 0
+      || multicast_group_address_.get_type() != AF_INET) {
+    return multicast_group_address_;
+  }
+
+  // FNV-1a, every process has to pick the same group for a topic
+  ACE_UINT32 hash = 2166136261u;
+  for (size_t i = 0; i < topic_name.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned char>(topic_name[i])) * 16777619u;
+  }
+  const ACE_UINT32 offset =
+    1 + static_cast<ACE_UINT32>(hash % topic_multicast_group_count_);
+  return ACE_INET_Addr(multicast_group_address_.get_port_number(),
+                       multicast_group_address_.get_ip_address() + offset);
+}
+
 size_t
 RtpsUdpInst::populate_locator(OpenDDS::DCPS::TransportLocator& info) const
+{
+  return populate_locator(info, multicast_group_address_);
+}
+
+size_t
+RtpsUdpInst::populate_locator(OpenDDS::DCPS::TransportLocator& info,
+                              const ACE_INET_Addr& multicast_group) const
 {
   using namespace OpenDDS::RTPS;
 
@@ -154,13 +251,12 @@ RtpsUdpInst::populate_locator(OpenDDS::DCPS::TransportLocator& info) const
   CORBA::ULong idx = 0;
 
   // multicast first so it's preferred by remote peers
-  if (this->use_multicast_ && this->multicast_group_address_ != ACE_INET_Addr()) {
+  if (this->use_multicast_ && multicast_group != ACE_INET_Addr()) {
     idx = locators.length();
     locators.length(idx + 1);
-    locators[idx].kind = address_to_kind(this->multicast_group_address_);
-    locators[idx].port = this->multicast_group_address_.get_port_number();
-    RTPS::address_to_bytes(locators[idx].address,
-                           this->multicast_group_address_);
+    locators[idx].kind = address_to_kind(multicast_group);
+    locators[idx].port = multicast_group.get_port_number();
+    RTPS::address_to_bytes(locators[idx].address, multicast_group);
   }
 
   //if local_address_string is empty, or only the port has been set
@@ -39,6 +39,48 @@ public:
   ACE_Time_Value nak_response_delay_, heartbeat_period_,
     heartbeat_response_delay_, handshake_timeout_, durable_data_timeout_;
 
+  /// A writer whose data is acknowledged by all of its readers doubles the
+  /// number of heartbeat periods between its heartbeats, up to this many
+  /// but at most 5, half the heartbeat periods after which a reader
+  /// considers a silent writer gone.  1, the default, keeps sending them
+  /// every heartbeat_period_.
+  size_t max_heartbeat_backoff_;
+
+  /// A sample requested by at least this many reader addresses in one
+  /// retransmit cycle is resent once to multicast_group_address_ instead of
+  /// to each of them.  0 always resends to the requesting readers only.
+  size_t repair_multicast_threshold_;
+
+  /// The most samples a writer resends per retransmit cycle
+  /// (nak_response_delay_), 0 for no limit.  Readers that are not repaired
+  /// request the rest again after the next heartbeat.
+  size_t max_repair_samples_;
+
+  /// The most bytes of out-of-order samples a reader holds for one writer
+  /// until the missing ones arrive, 0 for no limit.  A sample that does not
+  /// fit evicts the held samples after it, or is dropped if there are none.
+  /// Evicted and dropped samples are not acknowledged and are requested
+  /// again later.
+  size_t max_held_bytes_;
+
+  /// Run on the reactor thread shared by all transports that set this,
+  /// instead of a thread of its own.
+  bool shared_reactor_;
+
+  /// Multicast groups of the DataReaders of some topics, by topic name.
+  /// Their port is the one of multicast_group_address_.
+  typedef OPENDDS_MAP(OPENDDS_STRING, ACE_INET_Addr) TopicGroups;
+  TopicGroups topic_multicast_groups_;
+
+  /// The DataReaders of topics not in topic_multicast_groups_ use one of
+  /// this many groups, by a hash of the topic name, that follow an IPv4
+  /// multicast_group_address_.  0 puts them in multicast_group_address_.
+  size_t topic_multicast_group_count_;
+
+  /// The multicast group advertised by, and joined for, the DataReaders of
+  /// topic_name.
+  ACE_INET_Addr topic_multicast_group(const OPENDDS_STRING& topic_name) const;
+
   virtual int load(ACE_Configuration_Heap& cf,
                    ACE_Configuration_Section_Key& sect);
 
@@ -49,6 +91,8 @@ public:
   bool requires_cdr() const { return true; }
 
   virtual size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info) const;
+  size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info,
+                          const ACE_INET_Addr& multicast_group) const;
   const TransportBLOB* get_blob(const OpenDDS::DCPS::TransportLocatorSeq& trans_info) const;
 
   OPENDDS_STRING local_address_string() const { return local_address_config_str_; }
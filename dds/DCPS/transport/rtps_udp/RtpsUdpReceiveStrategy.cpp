@@ -26,6 +26,8 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const Guid
   , last_received_()
   , recvd_sample_(0)
   , receiver_(local_prefix)
+  , unmatched_data_dropped_(0)
+  , foreign_data_dropped_(0)
 #if defined(OPENDDS_SECURITY)
   , secure_sample_(0)
 #endif
@@ -33,6 +35,7 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const Guid
 #if defined(OPENDDS_SECURITY)
   secure_prefix_.smHeader.submessageId = SUBMESSAGE_NONE;
 #endif
+  received_sample_header().data_filter(this);
 }
 
 int
@@ -544,6 +547,49 @@ RtpsUdpReceiveStrategy::stop_i()
     reactor->remove_handler(link_->multicast_socket().get_handle(),
                             ACE_Event_Handler::READ_MASK);
   }
+
+  if (Transport_debug_level) {
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy::stop_i: ")
+               ACE_TEXT("skipped %B DATA submessages of unmatched writers ")
+               ACE_TEXT("and %B addressed to other participants\n"),
+               unmatched_data_dropped_, foreign_data_dropped_));
+  }
+}
+
+bool
+RtpsUdpReceiveStrategy::accept_data(const EntityId_t& writer_id)
+{
+#if defined(OPENDDS_SECURITY)
+  if (secure_prefix_.smHeader.submessageId) {
+    // the secure envelope is verified as a whole, see deliver_sample()
+    return true;
+  }
+#endif
+
+  if (std::memcmp(receiver_.dest_guid_prefix_, link_->local_prefix(),
+                  sizeof(GuidPrefix_t))) {
+    ++foreign_data_dropped_;
+    return false;
+  }
+
+  RepoId writer;
+  std::memcpy(writer.guidPrefix, receiver_.source_guid_prefix_,
+              sizeof(GuidPrefix_t));
+  writer.entityId = writer_id;
+
+  // Without a matched DataReader, data_received_i() still hands samples to
+  // the default listener (SEDP's), and builtin writers are never matched.
+  if (GuidConverter(writer).isBuiltinDomainEntity()
+      || link_->default_listener()) {
+    return true;
+  }
+
+  if (!link_->is_matched_writer(writer)) {
+    ++unmatched_data_dropped_;
+    return false;
+  }
+  return true;
 }
 
 bool
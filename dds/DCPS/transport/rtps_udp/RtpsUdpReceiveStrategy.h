@@ -31,7 +31,8 @@ class ReceivedDataSample;
 
 class OpenDDS_Rtps_Udp_Export RtpsUdpReceiveStrategy
   : public TransportReceiveStrategy<RtpsTransportHeader, RtpsSampleHeader>,
-    public RcEventHandler
+    public RcEventHandler,
+    public RtpsSampleHeader::DataFilter
 {
 public:
   explicit RtpsUdpReceiveStrategy(RtpsUdpDataLink* link, const GuidPrefix_t& local_prefix);
@@ -62,7 +63,17 @@ public:
   const ReceivedDataSample* withhold_data_from(const RepoId& sub_id);
   void do_not_withhold_data_from(const RepoId& sub_id);
 
+  /// Number of DATA and DATA_FRAG Submessages skipped without being parsed
+  /// since no local DataReader is associated with their writer.
+  size_t unmatched_data_dropped() const { return unmatched_data_dropped_; }
+
+  /// Number of DATA and DATA_FRAG Submessages skipped without being parsed
+  /// since an INFO_DST addressed them to another participant.
+  size_t foreign_data_dropped() const { return foreign_data_dropped_; }
+
 private:
+  virtual bool accept_data(const EntityId_t& writer_id);
+
   virtual ssize_t receive_bytes(iovec iov[],
                                 int n,
                                 ACE_INET_Addr& remote_address,
@@ -131,6 +142,8 @@ private:
   MessageReceiver receiver_;
   ACE_INET_Addr remote_address_;
 
+  size_t unmatched_data_dropped_, foreign_data_dropped_;
+
 #if defined(OPENDDS_SECURITY)
   RTPS::SecuritySubmessage secure_prefix_;
   OPENDDS_VECTOR(RTPS::Submessage) secure_submessages_;
@@ -209,6 +209,11 @@ RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
   if (link_->config().rtps_relay_address() != ACE_INET_Addr()) {
     send_single_i(iov, n, link_->config().rtps_relay_address());
   }
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+  if (addrs.size() > 1) {
+    return send_mmsg_i(iov, n, addrs);
+  }
+#endif
   ssize_t result = -1;
   typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
   for (iter_t iter = addrs.begin(); iter != addrs.end(); ++iter) {
@@ -220,6 +225,50 @@ RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
   return result;
 }
 
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+ssize_t
+RtpsUdpSendStrategy::send_mmsg_i(const iovec iov[], int n,
+                                 const OPENDDS_SET(ACE_INET_Addr)& addrs)
+{
+  // Every destination gets the same gather list, only the address differs.
+  OPENDDS_VECTOR(mmsghdr) msgs(addrs.size());
+  OPENDDS_VECTOR(const ACE_INET_Addr*) dests;
+  dests.reserve(addrs.size());
+
+  typedef OPENDDS_SET(ACE_INET_Addr)::const_iterator iter_t;
+  for (iter_t iter = addrs.begin(); iter != addrs.end(); ++iter) {
+    msghdr& hdr = msgs[dests.size()].msg_hdr;
+    hdr.msg_name = iter->get_addr();
+    hdr.msg_namelen = iter->get_size();
+    hdr.msg_iov = const_cast<iovec*>(iov);
+    hdr.msg_iovlen = n;
+    dests.push_back(&*iter);
+  }
+
+  const ACE_HANDLE handle = link_->unicast_socket().get_handle();
+  ssize_t result = -1;
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    const int count = ::sendmmsg(handle, &msgs[sent],
+                                 static_cast<unsigned int>(msgs.size() - sent),
+                                 0);
+    if (count > 0) {
+      result = msgs[sent].msg_len;
+      sent += count;
+    } else {
+      // sendmmsg() stops at the first destination that fails, send that one
+      // on its own (which reports the error) and continue with the rest.
+      const ssize_t result_per_dest = send_single_i(iov, n, *dests[sent]);
+      if (result_per_dest >= 0) {
+        result = result_per_dest;
+      }
+      ++sent;
+    }
+  }
+  return result;
+}
+#endif
+
 ssize_t
 RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
                                    const ACE_INET_Addr& addr)
@@ -20,6 +20,11 @@
 
 #include "ace/INET_Addr.h"
 
+#if defined ACE_LINUX && defined __GLIBC__ && !defined ACE_LACKS_SENDMSG
+// sendmmsg() submits the datagrams for all destinations in one system call
+# define OPENDDS_RTPS_UDP_SENDMMSG
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -58,14 +63,16 @@ public:
                       RTPS::SubmessageSeq& submessages);
 #endif
 
-protected:
-  virtual ssize_t send_bytes_i(const iovec iov[], int n);
-  ssize_t send_bytes_i_helper(const iovec iov[], int n);
-
+  /// Also bounds the submessages the DataLink combines in one RTPS Message.
   virtual size_t max_message_size() const
   {
     return UDP_MAX_MESSAGE_SIZE;
   }
+
+protected:
+  virtual ssize_t send_bytes_i(const iovec iov[], int n);
+  ssize_t send_bytes_i_helper(const iovec iov[], int n);
+
   virtual void add_delayed_notification(TransportQueueElement* element);
   virtual RemoveResult do_remove_sample(const RepoId& pub_id,
     const TransportQueueElement::MatchCriteria& criteria,
@@ -77,6 +84,10 @@ private:
                        const OPENDDS_SET(ACE_INET_Addr)& addrs);
   ssize_t send_single_i(const iovec iov[], int n,
                         const ACE_INET_Addr& addr);
+#ifdef OPENDDS_RTPS_UDP_SENDMMSG
+  ssize_t send_mmsg_i(const iovec iov[], int n,
+                      const OPENDDS_SET(ACE_INET_Addr)& addrs);
+#endif
 
 #if defined(OPENDDS_SECURITY)
   ACE_Message_Block* pre_send_packet(const ACE_Message_Block* plain);
@@ -23,6 +23,8 @@
 #include "ace/Log_Msg.h"
 #include "ace/Sock_Connect.h"
 
+#include <cstring>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -67,6 +69,22 @@ RtpsUdpTransport::make_datalink(const GuidPrefix_t& local_prefix)
   // RtpsUdpDataLink now owns the socket
   unicast_socket_.set_handle(ACE_INVALID_HANDLE);
 
+  for (TopicGroupMap::iterator it = topic_groups_.begin();
+       it != topic_groups_.end();) {
+    if (link->join_multicast_group(it->first)) {
+      ++it;
+      continue;
+    }
+    ACE_TCHAR addr[64];
+    it->first.addr_to_string(addr, sizeof addr / sizeof addr[0]);
+    ACE_ERROR((LM_WARNING,
+               ACE_TEXT("(%P|%t) WARNING: RtpsUdpTransport::make_datalink: ")
+               ACE_TEXT("topic multicast group %s not joined, its DataReaders ")
+               ACE_TEXT("only receive unicast\n"),
+               addr));
+    topic_groups_.erase(it++);
+  }
+
   return link;
 }
 
@@ -207,6 +225,64 @@ RtpsUdpTransport::connection_info_i(TransportLocator& info) const
   return true;
 }
 
+bool
+RtpsUdpTransport::topic_connection_info_i(TransportLocator& info,
+                                          const RepoId& participant,
+                                          const OPENDDS_STRING& topic_name)
+{
+  const RtpsUdpInst& config = this->config();
+  ACE_INET_Addr group = config.topic_multicast_group(topic_name);
+
+  if (config.use_multicast_ && group != config.multicast_group_address_) {
+    GuardThreadType guard_links(links_lock_);
+    // The group is joined before it is advertised, so that a DataReader
+    // never advertises a group it doesn't receive.
+    if (!link_ && participant != GUID_UNKNOWN) {
+      link_ = make_datalink(participant.guidPrefix);
+    }
+    if (!link_) {
+      group = config.multicast_group_address_;
+    } else if (++topic_groups_[group] == 1
+               && !link_->join_multicast_group(group)) {
+      // keep the DataReader reachable through the shared group
+      topic_groups_.erase(group);
+      group = config.multicast_group_address_;
+    }
+  }
+
+  config.populate_locator(info, group);
+  return true;
+}
+
+void
+RtpsUdpTransport::release_topic_connection_info_i(const TransportLocator& info)
+{
+  if (std::strcmp(info.transport_type.in(), "rtps_udp") != 0) {
+    return;
+  }
+  LocatorSeq locators;
+  if (RTPS::blob_to_locators(info.data, locators) != DDS::RETCODE_OK) {
+    return;
+  }
+
+  GuardThreadType guard_links(links_lock_);
+  for (CORBA::ULong i = 0; i < locators.length(); ++i) {
+    ACE_INET_Addr group;
+    if (RTPS::locator_to_address(group, locators[i], false) != 0) {
+      continue;
+    }
+    const TopicGroupMap::iterator it = topic_groups_.find(group);
+    if (it == topic_groups_.end() || --it->second) {
+      continue;
+    }
+    // The last DataReader of the group is gone
+    topic_groups_.erase(it);
+    if (link_) {
+      link_->leave_multicast_group(group);
+    }
+  }
+}
+
 void
 RtpsUdpTransport::register_for_reader(const RepoId& participant,
                                       const RepoId& writerid,
@@ -301,7 +377,7 @@ RtpsUdpTransport::configure_i(RtpsUdpInst& config)
     config.local_address_set_port(address.get_port_number());
   }
 
-  create_reactor_task();
+  create_reactor_task(false, config.shared_reactor_);
 
   if (config.opendds_discovery_default_listener_) {
     link_= make_datalink(config.opendds_discovery_guid_.guidPrefix);
@@ -68,6 +68,10 @@ private:
                                      const RepoId& /*writerid*/);
 
   virtual bool connection_info_i(TransportLocator& info) const;
+  virtual bool topic_connection_info_i(TransportLocator& info,
+                                       const RepoId& participant,
+                                       const OPENDDS_STRING& topic_name);
+  virtual void release_topic_connection_info_i(const TransportLocator& info);
   ACE_INET_Addr get_connection_addr(const TransportBLOB& data,
                                     bool* requires_inline_qos = 0,
                                     unsigned int* blob_bytes_read = 0) const;
@@ -113,6 +117,12 @@ private:
   RtpsUdpDataLink_rch link_;
   bool map_ipv4_to_ipv6() const;
 
+  /// Per-topic multicast groups advertised by DataReaders using this
+  /// transport and the number of those DataReaders, joined by link_ and
+  /// left when the count drops to zero (also protected by links_lock_).
+  typedef OPENDDS_MAP(ACE_INET_Addr, size_t) TopicGroupMap;
+  TopicGroupMap topic_groups_;
+
   ACE_SOCK_Dgram unicast_socket_;
 
   TransportClient_wrch default_listener_;
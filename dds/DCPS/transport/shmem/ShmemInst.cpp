@@ -25,6 +25,7 @@ ShmemInst::ShmemInst(const std::string& name)
   : TransportInst("shmem", name)
   , pool_size_(16 * 1024 * 1024)
   , datalink_control_size_(4 * 1024)
+  , share_payloads_(false)
   , hostname_(get_fully_qualified_hostname())
 {
   std::ostringstream pool;
@@ -48,6 +49,7 @@ ShmemInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_size"), pool_size_, size_t)
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("datalink_control_size"),
                    datalink_control_size_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("share_payloads"), share_payloads_, bool)
   return 0;
 }
 
@@ -58,7 +60,8 @@ ShmemInst::dump_to_str() const
   os << TransportInst::dump_to_str() << std::endl;
   os << formatNameForDump("pool_size") << pool_size_ << "\n"
      << formatNameForDump("datalink_control_size") << datalink_control_size_
-     << std::endl;
+     << "\n"
+     << formatNameForDump("share_payloads") << share_payloads_ << std::endl;
   return OPENDDS_STRING(os.str());
 }
 
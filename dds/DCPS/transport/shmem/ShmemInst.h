@@ -35,6 +35,11 @@ public:
   /// Defaults to 4 kilobytes.
   size_t datalink_control_size_;
 
+  /// Store a payload sent to several peers (the other processes of this
+  /// host) once in the shared-memory pool, reference counted, instead of
+  /// once per peer.  Defaults to false.
+  bool share_payloads_;
+
   bool is_reliable() const { return true; }
 
   virtual size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info) const;
@@ -91,41 +91,27 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     return -1;
   }
 
-  //FUTURE: use the ShmemTransport object to see if we already have the
-  //        same payload data available in the pool (from other DataLinks),
-  //        and if so, add a refcount to the start of the "from_pool" allocation
-
   size_t pool_alloc_size = 0;
   for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
     pool_alloc_size += iov[i].iov_len;
   }
 
   ShmemAllocator* alloc = link_->local_allocator();
-  void* from_pool = alloc->malloc(pool_alloc_size);
-  if (from_pool == 0) {
+  char* payload = link_->impl().alloc_payload(iov, n, pool_alloc_size);
+  if (payload == 0) {
     VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
               "to allocate %B bytes for data\n", link_, pool_alloc_size), 0);
     errno = ENOMEM;
     return -1;
   }
 
-  char* payload = reinterpret_cast<char*>(from_pool);
-  char* iter = payload;
-  for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
-    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
-    iter += iov[i].iov_len;
-  }
-
   void* mem = 0;
   alloc->find(bound_name_.c_str(), mem);
 
   for (ShmemData* iter = reinterpret_cast<ShmemData*>(mem);
        iter->status_ != SHMEM_DATA_END_OF_ALLOC; ++iter) {
     if (iter->status_ == SHMEM_DATA_RECV_DONE) {
-      alloc->free(iter->payload_);
-      // This will eventually be refcounted so instead of a free(), the previous
-      // statement would decrement the refcount and check for 0 before free().
-      // See the 'FUTURE' comment above.
+      link_->impl().free_payload(iter->payload_);
       iter->status_ = SHMEM_DATA_FREE;
       VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
                 "releasing control block #%d\n", link_,
@@ -144,6 +130,7 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     } else if (start == current_data_) {
       VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ out of "
                 "space for control\n", link_), 0);
+      link_->impl().free_payload(payload);
       return -1;
     }
     if (current_data_[1].status_ == SHMEM_DATA_END_OF_ALLOC) {
@@ -163,6 +150,7 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
   } else {
     VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ "
               "failed to find space for control\n", link_), 0);
+    link_->impl().free_payload(payload);
     return -1;
   }
 
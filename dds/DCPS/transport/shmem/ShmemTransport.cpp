@@ -19,6 +19,23 @@
 #include <sstream>
 #include <cstring>
 
+namespace {
+  // Compares a payload in the pool with the bytes it would be copied from.
+  // This reads size bytes from each side, about what the memcpy it saves
+  // would touch, but it is only done when the index already has a copy of
+  // the same address and size, and a match also saves the pool allocation.
+  bool same_bytes(const char* payload, const iovec iov[], int n)
+  {
+    for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
+      if (std::memcmp(payload, iov[i].iov_base, iov[i].iov_len) != 0) {
+        return false;
+      }
+      payload += iov[i].iov_len;
+    }
+    return true;
+  }
+}
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -26,6 +43,7 @@ namespace DCPS {
 
 ShmemTransport::ShmemTransport(ShmemInst& inst)
   : TransportImpl(inst)
+  , payloads_reused_(0)
 {
   if (! (configure_i(inst) && open()) ) {
     throw Transport::UnableToCreate();
@@ -183,6 +201,12 @@ ShmemTransport::shutdown_i()
 
   read_task_.reset();
 
+  {
+    GuardType payloads_guard(payloads_lock_);
+    shared_payloads_.clear();
+    payload_index_.clear();
+  }
+
   if (alloc_) {
 #ifndef OPENDDS_SHMEM_UNSUPPORTED
     void* mem = 0;
@@ -287,6 +311,84 @@ ShmemTransport::signal_semaphore()
   ACE_OS::sema_post(&read_task_->semaphore_);
 }
 
+char*
+ShmemTransport::alloc_payload(const iovec iov[], int n, size_t size)
+{
+  // The samples sent to each peer share their message blocks, so the same
+  // payload is found at the same address for every DataLink.
+  const bool share = config().share_payloads_ && size && n > 1;
+  const PayloadKey key(iov[n > 1 ? 1 : 0].iov_base, size);
+
+  if (share) {
+    GuardType guard(payloads_lock_);
+    const PayloadIndex::iterator found = payload_index_.find(key);
+    // the address may have been reused for other bytes, compare before sharing
+    if (found != payload_index_.end() && same_bytes(found->second, iov, n)) {
+      ++shared_payloads_[found->second].refs_;
+      ++payloads_reused_;
+      VDBG((LM_DEBUG, "(%P|%t) ShmemTransport::alloc_payload "
+            "sharing payload %@ len %B\n", found->second, size));
+      return found->second;
+    }
+  }
+
+  char* const payload = static_cast<char*>(alloc_->malloc(size));
+  if (payload == 0) {
+    return 0;
+  }
+
+  char* iter = payload;
+  for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
+    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
+    iter += iov[i].iov_len;
+  }
+
+  if (share) {
+    GuardType guard(payloads_lock_);
+    // replaces any previous payload copied from the same (reused) address
+    payload_index_[key] = payload;
+    SharedPayload& shared = shared_payloads_[payload];
+    shared.key_ = key;
+    shared.refs_ = 1;
+  }
+  return payload;
+}
+
+void
+ShmemTransport::free_payload(char* payload)
+{
+  if (config().share_payloads_) {
+    GuardType guard(payloads_lock_);
+    const SharedPayloadMap::iterator shared = shared_payloads_.find(payload);
+    if (shared != shared_payloads_.end()) {
+      if (--shared->second.refs_) {
+        return;
+      }
+      const PayloadIndex::iterator found =
+        payload_index_.find(shared->second.key_);
+      if (found != payload_index_.end() && found->second == payload) {
+        payload_index_.erase(found);
+      }
+      shared_payloads_.erase(shared);
+    }
+  }
+  alloc_->free(payload);
+}
+
+size_t
+ShmemTransport::shared_payloads()
+{
+  GuardType guard(payloads_lock_);
+  return shared_payloads_.size();
+}
+
+size_t
+ShmemTransport::payloads_reused()
+{
+  GuardType guard(payloads_lock_);
+  return payloads_reused_;
+}
+
 std::string
 ShmemTransport::address()
 {
@@ -34,6 +34,24 @@ public:
   std::string address();
   void signal_semaphore();
 
+  /// Copy the payload in iov[1] .. iov[n - 1] (size bytes) to the pool.
+  /// With ShmemInst::share_payloads_, a copy of the same bytes made for
+  /// another DataLink is reused instead.  Returns 0 if the pool is full.
+  char* alloc_payload(const iovec iov[], int n, size_t size);
+
+  /// Release a payload from alloc_payload() once its peer has read it.
+  void free_payload(char* payload);
+
+  /// Diagnostics for tests and monitoring, not used by the transport itself.
+  /// Both only count with ShmemInst::share_payloads_ and take payloads_lock_.
+  //@{
+  /// Number of payloads from alloc_payload() that some peer hasn't read yet.
+  size_t shared_payloads();
+
+  /// Number of times alloc_payload() reused a copy instead of making one.
+  size_t payloads_reused();
+  //@}
+
   ShmemInst& config() const;
 
 protected:
@@ -82,6 +100,21 @@ private:
 
   unique_ptr<ShmemAllocator> alloc_;
 
+  /// Payloads used by more than one DataLink are counted here, the index
+  /// finds them by the address and size of the bytes they were copied
+  /// from.  Protected by payloads_lock_.
+  typedef std::pair<const void*, size_t> PayloadKey;
+  struct SharedPayload {
+    PayloadKey key_;
+    size_t refs_;
+  };
+  typedef OPENDDS_MAP(char*, SharedPayload) SharedPayloadMap;
+  SharedPayloadMap shared_payloads_;
+  typedef OPENDDS_MAP(PayloadKey, char*) PayloadIndex;
+  PayloadIndex payload_index_;
+  size_t payloads_reused_;
+  LockType payloads_lock_;
+
   struct ReadTask : ACE_Task_Base {
     ReadTask(ShmemTransport* outer, ACE_sema_t semaphore);
     int svc();
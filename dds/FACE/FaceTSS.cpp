@@ -672,7 +672,12 @@ namespace {
         pub->create_datawriter(topic, datawriter_qos, 0, 0);
       if (!dw) return INVALID_PARAM;
 
-      Entities::instance()->senders_[connectionId].dw = dw;
+      Entities::FaceSender& sender = Entities::instance()->senders_[connectionId];
+      sender.dw = dw;
+      sender.reliable =
+        datawriter_qos.reliability.kind == DDS::RELIABLE_RELIABILITY_QOS;
+      sender.max_blocking_time =
+        convertDuration(datawriter_qos.reliability.max_blocking_time);
 
     } else { // dir == DESTINATION
       DDS::SubscriberQos subscriber_qos;
@@ -30,8 +30,15 @@ public:
     FACE::VALIDITY_TYPE status_valid;
   };
   struct FaceSender : public DDSAdapter {
-    FaceSender () {}
+    FaceSender ()
+      : reliable(false),
+        max_blocking_time(0)
+    {}
     DDS::DataWriter_var dw;
+    /// Cached from the DataWriter's QoS when the connection is created so
+    /// send_message doesn't need to call get_qos for each message.
+    bool reliable;
+    FACE::SYSTEM_TIME_TYPE max_blocking_time;
   };
 
   struct FaceReceiver : public DDSAdapter {
@@ -179,28 +186,44 @@ void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
     }
     readers[connection_id]->status_valid = FACE::VALID;
 
-    const DDS::ReadCondition_var rc =
-      typedReader->create_readcondition(DDS::ANY_SAMPLE_STATE,
-        DDS::ANY_VIEW_STATE,
-        DDS::ALIVE_INSTANCE_STATE);
-    const DDS::WaitSet_var ws = new DDS::WaitSet;
-    ws->attach_condition(rc);
+    // Samples are loaned from the DataReader, so the only copy made is the
+    // one into the caller's message.  Try a take before setting up a
+    // WaitSet, which is only needed when no data is available yet.
+    typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
+    DDS::SampleInfoSeq sinfo;
+    DDS::ReturnCode_t ret =
+      typedReader->take(seq, sinfo, 1 /*max*/, DDS::ANY_SAMPLE_STATE,
+                        DDS::ANY_VIEW_STATE, DDS::ALIVE_INSTANCE_STATE);
+
+    if (ret == DDS::RETCODE_NO_DATA) {
+      if (timeout == 0) {
+        // Same as a WaitSet timing out immediately
+        return_code = update_status(connection_id, DDS::RETCODE_TIMEOUT);
+        return;
+      }
 
-    DDS::ConditionSeq active;
-    const DDS::Duration_t ddsTimeout = convertTimeout(timeout);
-    DDS::ReturnCode_t ret = ws->wait(active, ddsTimeout);
-    ws->detach_condition(rc);
+      const DDS::ReadCondition_var rc =
+        typedReader->create_readcondition(DDS::ANY_SAMPLE_STATE,
+          DDS::ANY_VIEW_STATE,
+          DDS::ALIVE_INSTANCE_STATE);
+      const DDS::WaitSet_var ws = new DDS::WaitSet;
+      ws->attach_condition(rc);
+
+      DDS::ConditionSeq active;
+      const DDS::Duration_t ddsTimeout = convertTimeout(timeout);
+      ret = ws->wait(active, ddsTimeout);
+      ws->detach_condition(rc);
+
+      if (ret == DDS::RETCODE_TIMEOUT) {
+        typedReader->delete_readcondition(rc);
+        return_code = update_status(connection_id, ret);
+        return;
+      }
 
-    if (ret == DDS::RETCODE_TIMEOUT) {
+      ret = typedReader->take_w_condition(seq, sinfo, 1 /*max*/, rc);
       typedReader->delete_readcondition(rc);
-      return_code = update_status(connection_id, ret);
-      return;
     }
 
-    typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
-    DDS::SampleInfoSeq sinfo;
-    ret = typedReader->take_w_condition(seq, sinfo, 1 /*max*/, rc);
-    typedReader->delete_readcondition(rc);
     if (ret == DDS::RETCODE_OK && sinfo[0].valid_data) {
       DDS::Subscriber_var subscriber = typedReader->get_subscriber();
       DDS::DomainParticipant_var participant = subscriber->get_participant();
@@ -227,49 +250,111 @@ void receive_message(/*in*/    FACE::CONNECTION_ID_TYPE connection_id,
 }
 
 template <typename Msg>
-void send_message(FACE::CONNECTION_ID_TYPE connection_id,
-                  FACE::TIMEOUT_TYPE timeout,
-                  FACE::TRANSACTION_ID_TYPE& /*transaction_id*/,
-                  const Msg& message,
-                  FACE::MESSAGE_SIZE_TYPE message_size,
-                  FACE::RETURN_CODE_TYPE& return_code)
+typename DCPS::DDSTraits<Msg>::DataWriterType::_ptr_type
+sender_writer(FACE::CONNECTION_ID_TYPE connection_id,
+              FACE::TIMEOUT_TYPE timeout,
+              FACE::MESSAGE_SIZE_TYPE message_size,
+              FACE::RETURN_CODE_TYPE& return_code)
 {
+  typedef typename DCPS::DDSTraits<Msg>::DataWriterType DataWriter;
   if(!Entities::instance()->connections_.count(connection_id)) {
     return_code = FACE::INVALID_PARAM;
-    return;
+    return DataWriter::_nil();
   }
   FACE::TRANSPORT_CONNECTION_STATUS_TYPE status =
     Entities::instance()->connections_[connection_id].connection_status;
   if (message_size < status.MAX_MESSAGE_SIZE) {
     return_code = FACE::INVALID_PARAM;
-    return;
+    return DataWriter::_nil();
   }
   Entities::ConnIdToSenderMap& writers = Entities::instance()->senders_;
-  if (!writers.count(connection_id)) {
+  const Entities::ConnIdToSenderMap::iterator iter = writers.find(connection_id);
+  if (iter == writers.end()) {
+    return_code = FACE::INVALID_PARAM;
+    return DataWriter::_nil();
+  }
+  Entities::FaceSender& sender = iter->second;
+
+  typename DataWriter::_var_type typedWriter = DataWriter::_narrow(sender.dw);
+  if (!typedWriter) {
+    return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
+    return DataWriter::_nil();
+  }
+  sender.status_valid = FACE::VALID;
+
+  if (sender.reliable &&
+      timeout != FACE::INF_TIME_VALUE &&
+      ((sender.max_blocking_time == FACE::INF_TIME_VALUE) ||
+       (timeout < sender.max_blocking_time))) {
+    return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
+    return DataWriter::_nil();
+  }
+
+  return_code = FACE::RC_NO_ERROR;
+  return typedWriter._retn();
+}
+
+/// OpenDDS extension: register the instance identified by the key fields
+/// of message with the connection's DataWriter.  The resulting handle can be
+/// passed to the send_message overload below so the instance isn't looked
+/// up again for each message.
+template <typename Msg>
+void register_instance(FACE::CONNECTION_ID_TYPE connection_id,
+                       const Msg& message,
+                       DDS::InstanceHandle_t& handle,
+                       FACE::RETURN_CODE_TYPE& return_code)
+{
+  handle = DDS::HANDLE_NIL;
+  Entities::ConnIdToSenderMap& writers = Entities::instance()->senders_;
+  const Entities::ConnIdToSenderMap::iterator iter = writers.find(connection_id);
+  if (iter == writers.end()) {
     return_code = FACE::INVALID_PARAM;
     return;
   }
 
   typedef typename DCPS::DDSTraits<Msg>::DataWriterType DataWriter;
   const typename DataWriter::_var_type typedWriter =
-    DataWriter::_narrow(writers[connection_id].dw);
+    DataWriter::_narrow(iter->second.dw);
   if (!typedWriter) {
     return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
     return;
   }
-  writers[connection_id].status_valid = FACE::VALID;
 
-  DDS::DataWriterQos dw_qos;
-  typedWriter->get_qos(dw_qos);
-  FACE::SYSTEM_TIME_TYPE max_blocking_time = convertDuration(dw_qos.reliability.max_blocking_time);
-  if (dw_qos.reliability.kind == DDS::RELIABLE_RELIABILITY_QOS &&
-      timeout != FACE::INF_TIME_VALUE &&
-      ((max_blocking_time == FACE::INF_TIME_VALUE) || (timeout < max_blocking_time))) {
-    return_code = update_status(connection_id, DDS::RETCODE_BAD_PARAMETER);
+  handle = typedWriter->register_instance(message);
+  return_code = update_status(connection_id, handle == DDS::HANDLE_NIL
+                              ? DDS::RETCODE_ERROR : DDS::RETCODE_OK);
+}
+
+/// OpenDDS extension: send_message for an instance previously registered
+/// with register_instance (or DDS::HANDLE_NIL to look it up from message).
+template <typename Msg>
+void send_message(FACE::CONNECTION_ID_TYPE connection_id,
+                  FACE::TIMEOUT_TYPE timeout,
+                  const Msg& message,
+                  DDS::InstanceHandle_t handle,
+                  FACE::MESSAGE_SIZE_TYPE message_size,
+                  FACE::RETURN_CODE_TYPE& return_code)
+{
+  typedef typename DCPS::DDSTraits<Msg>::DataWriterType DataWriter;
+  const typename DataWriter::_var_type typedWriter =
+    sender_writer<Msg>(connection_id, timeout, message_size, return_code);
+  if (!typedWriter) {
     return;
   }
 
-  return_code = update_status(connection_id, typedWriter->write(message, DDS::HANDLE_NIL));
+  return_code = update_status(connection_id, typedWriter->write(message, handle));
+}
+
+template <typename Msg>
+void send_message(FACE::CONNECTION_ID_TYPE connection_id,
+                  FACE::TIMEOUT_TYPE timeout,
+                  FACE::TRANSACTION_ID_TYPE& /*transaction_id*/,
+                  const Msg& message,
+                  FACE::MESSAGE_SIZE_TYPE message_size,
+                  FACE::RETURN_CODE_TYPE& return_code)
+{
+  send_message(connection_id, timeout, message, DDS::HANDLE_NIL,
+               message_size, return_code);
 }
 
 template <typename Msg>
@@ -321,12 +406,22 @@ private:
     }
 
     FACE::MESSAGE_TYPE_GUID& msg_id = Entities::instance()->connections_[connection_id_].platform_view_guid;
-    Msg sample;
-    DDS::SampleInfo sinfo;
-    while (typedReader->take_next_sample(sample, sinfo) == DDS::RETCODE_OK) {
+    DDS::Subscriber_var subscriber = typedReader->get_subscriber();
+    DDS::DomainParticipant_var participant = subscriber->get_participant();
+
+    // Take everything available as a loan so callbacks are handed the
+    // samples held by the DataReader instead of a copy of each one.  The
+    // loan is returned when seq goes out of scope.
+    typename DCPS::DDSTraits<Msg>::MessageSequenceType seq;
+    DDS::SampleInfoSeq sinfos;
+    if (typedReader->take(seq, sinfos, DDS::LENGTH_UNLIMITED,
+                          DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                          DDS::ANY_INSTANCE_STATE) != DDS::RETCODE_OK) {
+      return;
+    }
+    for (CORBA::ULong idx = 0; idx < seq.length(); ++idx) {
+      const DDS::SampleInfo& sinfo = sinfos[idx];
       if (sinfo.valid_data) {
-        DDS::Subscriber_var subscriber = typedReader->get_subscriber();
-        DDS::DomainParticipant_var participant = subscriber->get_participant();
         FACE::RETURN_CODE_TYPE ret_code;
         populate_header_received(connection_id_, participant, sinfo, ret_code);
         if (ret_code != FACE::RC_NO_ERROR) {
@@ -343,7 +438,7 @@ private:
         }
         for (size_t i = 0; i < callbacks_.size(); ++i) {
           retcode = FACE::RC_NO_ERROR;
-          callbacks_.at(i)(transaction_id /*Transaction_ID*/, sample, msg_id, sizeof(Msg), 0 /*WAITSET_TYPE*/, retcode);
+          callbacks_.at(i)(transaction_id /*Transaction_ID*/, seq[idx], msg_id, sizeof(Msg), 0 /*WAITSET_TYPE*/, retcode);
           if (retcode != FACE::RC_NO_ERROR) {
             ACE_ERROR((LM_ERROR, "ERROR: Listener::on_data_available - callback %d returned retcode: %d\n", i, retcode));
           }
@@ -244,7 +244,7 @@ dds_visitor::visit_structure(AST_Structure* node)
   }
 
   if (be_global->java()) {
-    java_ts_generator::generate(node->name());
+    java_ts_generator::generate(node);
   }
 
   return 0;
@@ -815,7 +815,7 @@ namespace {
               indent << typedefname << "_copy(arr" << nfl.index_ <<
               ", tmp.in());\n";
           } else {
-            string suffix = (elem_cls & CL_STRING) ? (use_cxx11 ? "" : ".out()") : "";
+            string suffix = (elem_cls & CL_STRING) ? (use_cxx11 ? "" : ".inout()") : "";
             string pre;
             if (use_cxx11 && (elem_cls & (CL_ARRAY | CL_SEQUENCE))) {
               pre = "IDL::DistinctType<" + cxx_elem + ", " +
@@ -1236,11 +1236,12 @@ namespace {
 
     WrapDirection dir = (shift == ">>") ? WD_INPUT : WD_OUTPUT;
     if ((fld_cls & CL_STRING) && (dir == WD_INPUT)) {
+      // inout() lets Serializer::read_string() reuse the current buffer
       if (fld_cls & CL_BOUNDED) {
-        const string args = expr + (use_cxx11 ? ", " : ".out(), ") + bounded_arg(type);
+        const string args = expr + (use_cxx11 ? ", " : ".inout(), ") + bounded_arg(type);
         return "(strm " + shift + ' ' + getWrapper(args, type, WD_INPUT) + ')';
       }
-      return "(strm " + qual + (use_cxx11 ? "" : ".out()") + ')';
+      return "(strm " + qual + (use_cxx11 ? "" : ".inout()") + ')';
     } else if (fld_cls & CL_PRIMITIVE) {
       return "(strm " + shift + ' ' + getWrapper(expr, type, dir) + ')';
     } else if (fld_cls == CL_UNKNOWN) {
@@ -1574,9 +1575,137 @@ namespace {
         "    && ";
     }
 
+    bool empty() const
+    {
+      return cst_.empty() && preamble_.empty();
+    }
+
     std::map<string, string> cst_;
     string iQosOffset_, preamble_;
   };
+
+  /// CDR layout of a struct made only of fixed-size primitives, arrays and
+  /// nested structs of those, where the native representation of each
+  /// primitive is its CDR representation (without byte swapping).
+  struct PodLayout {
+    PodLayout() : size(0), padding(0), first_align(0), max_align(1) {}
+
+    bool add(AST_Type* type)
+    {
+      type = resolveActualType(type);
+      switch (type->node_type()) {
+      case AST_Decl::NT_pre_defined: {
+        size_t len = 0;
+        switch (AST_PredefinedType::narrow_from_decl(type)->pt()) {
+        case AST_PredefinedType::PT_char:
+        case AST_PredefinedType::PT_octet:
+          len = 1;
+          break;
+        case AST_PredefinedType::PT_short:
+        case AST_PredefinedType::PT_ushort:
+          len = 2;
+          break;
+        case AST_PredefinedType::PT_long:
+        case AST_PredefinedType::PT_ulong:
+        case AST_PredefinedType::PT_float:
+          len = 4;
+          break;
+        case AST_PredefinedType::PT_longlong:
+        case AST_PredefinedType::PT_ulonglong:
+        case AST_PredefinedType::PT_double:
+          len = 8;
+          break;
+        default:
+          // boolean, wchar and long double don't have the same
+          // representation in memory and in CDR on all platforms
+          return false;
+        }
+        add_element(len, len, len);
+        return true;
+      }
+      case AST_Decl::NT_struct: {
+        const string cxx = scoped(type->name());
+        for (size_t i = 0; i < LENGTH(special_structs); ++i) {
+          if (special_structs[i].check(cxx)) {
+            return false;
+          }
+        }
+        if (!RtpsFieldCustomizer(cxx).empty()) {
+          return false;
+        }
+        AST_Structure* struct_node = dynamic_cast<AST_Structure*>(type);
+        for (unsigned long i = 0; i < struct_node->nfields(); ++i) {
+          AST_Field** f;
+          struct_node->field(f, i);
+          if (!add((*f)->field_type())) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case AST_Decl::NT_array: {
+        AST_Array* array_node = dynamic_cast<AST_Array*>(type);
+        PodLayout elem;
+        if (!elem.add(array_node->base_type()) || !elem.is_packed()) {
+          return false;
+        }
+        size_t n = 1;
+        AST_Expression** dims = array_node->dims();
+        for (unsigned long i = 0; i < array_node->n_dims(); ++i) {
+          n *= dims[i]->ev()->u.ulval;
+        }
+        add_element(elem.size * n, elem.first_align, elem.max_align);
+        return true;
+      }
+      default:
+        return false;
+      }
+    }
+
+    /// True if the CDR stream has no padding when the struct starts at a
+    /// multiple of max_align, so it also matches the native layout.
+    bool is_packed() const
+    {
+      return size && !padding && size % max_align == 0;
+    }
+
+    /// The Serializer array type that reads or writes 'size' bytes aligned
+    /// to max_align.
+    string array_type() const
+    {
+      switch (max_align) {
+      case 2: return "ushort";
+      case 4: return "ulong";
+      case 8: return "ulonglong";
+      default: return "octet";
+      }
+    }
+
+    string array_cxx() const
+    {
+      switch (max_align) {
+      case 2: return "ACE_CDR::UShort";
+      case 4: return "ACE_CDR::ULong";
+      case 8: return "ACE_CDR::ULongLong";
+      default: return "ACE_CDR::Octet";
+      }
+    }
+
+    size_t size, padding, first_align, max_align;
+
+  private:
+    void add_element(size_t len, size_t first, size_t alignment)
+    {
+      if (!first_align) {
+        first_align = first;
+      }
+      if (alignment > max_align) {
+        max_align = alignment;
+      }
+      align(alignment, size, padding);
+      size += len;
+    }
+  };
 }
 
 bool marshal_generator::gen_struct(AST_Structure* /* node */,
@@ -1596,6 +1725,27 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
   }
 
   RtpsFieldCustomizer rtpsCustom(cxx);
+
+  // A struct whose CDR layout matches its layout in memory is copied as a
+  // single block when the stream doesn't swap bytes.  The sizeof() check
+  // is a compile-time constant, so the field-wise code is all that remains
+  // if the compiler laid out the struct differently.
+  PodLayout pod;
+  bool is_pod = rtpsCustom.empty();
+  for (size_t i = 0; is_pod && i < fields.size(); ++i) {
+    is_pod = pod.add(fields[i]->field_type());
+  }
+  is_pod = is_pod && pod.is_packed();
+  string pod_cond;
+  if (is_pod) {
+    std::ostringstream cond;
+    cond << "sizeof(" << cxx << ") == " << pod.size << " && !strm.swap_bytes()";
+    if (pod.first_align != pod.max_align) {
+      // CDR alignment would add padding within the block
+      cond << "\n      && strm.alignment() == Serializer::ALIGN_NONE";
+    }
+    pod_cond = cond.str();
+  }
   {
     Function find_size("gen_find_size", "void");
     find_size.addArg("stru", "const " + cxx + "&");
@@ -1609,6 +1759,9 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
           && field_type->node_type() != AST_Decl::NT_pre_defined) {
         be_global->add_referenced(field_type->file_name().c_str());
       }
+      if (is_pod && pod.first_align == pod.max_align) {
+        continue;
+      }
       const string field_name = fields[i]->local_name()->get_string(),
         cond = rtpsCustom.getConditional(field_name);
       if (!cond.empty()) {
@@ -1619,6 +1772,19 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
         expr += "  }\n";
       }
     }
+    if (is_pod && pod.first_align == pod.max_align) {
+      std::ostringstream block;
+      block << "  ACE_UNUSED_ARG(stru);\n";
+      if (pod.max_align > 1) {
+        block <<
+          "  if ((size + padding) % " << pod.max_align << ") {\n"
+          "    padding += " << pod.max_align << " - ((size + padding) % "
+          << pod.max_align << ");\n"
+          "  }\n";
+      }
+      block << "  size += " << pod.size << ";\n";
+      expr = block.str();
+    }
     be_global->impl_ << intro << expr;
   }
   {
@@ -1627,6 +1793,16 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
     insertion.addArg("stru", "const " + cxx + "&");
     insertion.endArgs();
     string expr, intro = rtpsCustom.preamble_;
+    if (is_pod) {
+      std::ostringstream block;
+      block <<
+        "  if (" << pod_cond << ") {\n"
+        "    return strm.write_" << pod.array_type() << "_array(\n"
+        "      reinterpret_cast<const " << pod.array_cxx() << "*>(&stru), "
+        << pod.size / pod.max_align << ");\n"
+        "  }\n";
+      intro += block.str();
+    }
     for (size_t i = 0; i < fields.size(); ++i) {
       if (i) expr += "\n    && ";
       const string field_name = fields[i]->local_name()->get_string(),
@@ -1647,6 +1823,16 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
     extraction.addArg("stru", cxx + "&");
     extraction.endArgs();
     string expr, intro;
+    if (is_pod) {
+      std::ostringstream block;
+      block <<
+        "  if (" << pod_cond << ") {\n"
+        "    return strm.read_" << pod.array_type() << "_array(\n"
+        "      reinterpret_cast<" << pod.array_cxx() << "*>(&stru), "
+        << pod.size / pod.max_align << ");\n"
+        "  }\n";
+      intro += block.str();
+    }
     for (size_t i = 0; i < fields.size(); ++i) {
       if (i) expr += "\n    && ";
       const string field_name = fields[i]->local_name()->get_string(),
@@ -1826,6 +2012,56 @@ bool marshal_generator::gen_struct(AST_Structure* /* node */,
       else be_global->impl_ << intro << "  return " << expr << ";\n";
     }
 
+    {
+      // Extractions from a full (not key-only) sample split after the
+      // last member holding a key: KeyPrefix finds the instance of a
+      // sample without demarshaling all of it, KeySuffix continues with
+      // the remaining members on the same Serializer.
+      size_t key_prefix = 0;
+      IDL_GlobalData::DCPS_Data_Type_Info_Iter iter(info->key_list_);
+      for (ACE_TString* kp = 0; iter.next(kp) != 0; iter.advance()) {
+        const string key_name = ACE_TEXT_ALWAYS_CHAR(kp->c_str());
+        const string key_base = key_name.substr(0, key_name.find_first_of(".["));
+        for (size_t i = key_prefix; i < fields.size(); ++i) {
+          if (key_base == fields[i]->local_name()->get_string()) {
+            key_prefix = i + 1;
+            break;
+          }
+        }
+      }
+
+      {
+        Function extraction("operator>>", "bool");
+        extraction.addArg("strm", "Serializer&");
+        extraction.addArg("wrap", "KeyPrefix<" + cxx + ">");
+        extraction.endArgs();
+
+        string expr, intro = "  " + cxx + "& stru = wrap.t;\n";
+        for (size_t i = 0; i < key_prefix; ++i) {
+          if (i) expr += "\n    && ";
+          const string field_name = fields[i]->local_name()->get_string();
+          expr += streamCommon(field_name, fields[i]->field_type(), ">> stru", intro, cxx);
+        }
+        if (key_prefix == 0) be_global->impl_ << "  return true;\n";
+        else be_global->impl_ << intro << "  return " << expr << ";\n";
+      }
+      {
+        Function extraction("operator>>", "bool");
+        extraction.addArg("strm", "Serializer&");
+        extraction.addArg("wrap", "KeySuffix<" + cxx + ">");
+        extraction.endArgs();
+
+        string expr, intro = "  " + cxx + "& stru = wrap.t;\n";
+        for (size_t i = key_prefix; i < fields.size(); ++i) {
+          if (i > key_prefix) expr += "\n    && ";
+          const string field_name = fields[i]->local_name()->get_string();
+          expr += streamCommon(field_name, fields[i]->field_type(), ">> stru", intro, cxx);
+        }
+        if (key_prefix == fields.size()) be_global->impl_ << "  return true;\n";
+        else be_global->impl_ << intro << "  return " << expr << ";\n";
+      }
+    }
+
     be_global->header_ <<
       "template <>\n"
       "struct MarshalTraits<" << cxx << "> {\n"
@@ -75,30 +75,39 @@ namespace {
     }
   }
 
+  /// Expression for the Value of the scalar 'member' of type 'type', which
+  /// is named without the accessor parentheses of the C++11 mapping.
+  std::string scalar_value(AST_Type* type, const std::string& member)
+  {
+    const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
+    const Classification cls = classify(type);
+    std::string prefix, suffix;
+    if (cls & CL_ENUM) {
+      AST_Type* enum_type = resolveActualType(type);
+      prefix = "gen_" +
+        dds_generator::scoped_helper(enum_type->name(), "_")
+        + "_names[";
+      if (use_cxx11) {
+        prefix += "static_cast<int>(";
+      }
+      suffix = use_cxx11 ? "())]" : "]";
+    } else if (use_cxx11) {
+      suffix += "()";
+    }
+    const std::string string_to_ptr = use_cxx11 ? "" : ".in()";
+    return prefix + member + (cls & CL_STRING ? string_to_ptr : "") + suffix;
+  }
+
   void gen_field_getValue(AST_Field* field)
   {
     const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
     const Classification cls = classify(field->field_type());
     const std::string fieldName = field->local_name()->get_string();
     if (cls & CL_SCALAR) {
-      std::string prefix, suffix;
-      if (cls & CL_ENUM) {
-        AST_Type* enum_type = resolveActualType(field->field_type());
-        prefix = "gen_" +
-          dds_generator::scoped_helper(enum_type->name(), "_")
-          + "_names[";
-        if (use_cxx11) {
-          prefix += "static_cast<int>(";
-        }
-        suffix = use_cxx11 ? "())]" : "]";
-      } else if (use_cxx11) {
-        suffix += "()";
-      }
-      const std::string string_to_ptr = use_cxx11 ? "" : ".in()";
       be_global->impl_ <<
         "    if (std::strcmp(field, \"" << fieldName << "\") == 0) {\n"
-        "      return " + prefix + "typed." + fieldName
-        + (cls & CL_STRING ? string_to_ptr : "") + suffix + ";\n"
+        "      return " + scalar_value(field->field_type(), "typed." + fieldName)
+        + ";\n"
         "    }\n";
       be_global->add_include("<cstring>", BE_GlobalData::STREAM_CPP);
     } else if (cls & CL_STRUCTURE) {
@@ -170,9 +179,62 @@ namespace {
     return scoped(type->name());
   }
 
-  void gen_field_getValueFromSerialized(AST_Field* field)
+  /// Code that skips over 'field' in the Serializer 'ser'.
+  void gen_skip_field(AST_Field* field, const std::string& indent)
   {
     const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
+    AST_Type* type = field->field_type();
+    const Classification cls = classify(type);
+    const std::string fieldName = field->local_name()->get_string();
+    int size = 0;
+    const std::string cxx_type = to_cxx_type(type, size);
+    if (cls & CL_STRING) {
+      be_global->impl_ <<
+        indent << "ACE_CDR::ULong len;\n" <<
+        indent << "if (!(ser >> len)) {\n" <<
+        indent << "  throw std::runtime_error(\"String '" << fieldName <<
+        "' length could not be deserialized\");\n" <<
+        indent << "}\n" <<
+        indent << "if (!ser.skip(static_cast<ACE_UINT16>(len))) {\n" <<
+        indent << "  throw std::runtime_error(\"String '" << fieldName <<
+        "' contents could not be skipped\");\n" <<
+        indent << "}\n";
+    } else if ((cls & CL_SCALAR) && (cls & CL_WIDE)) {
+      be_global->impl_ <<
+        indent << "ACE_CDR::Octet len;\n" <<
+        indent << "if (!(ser >> ACE_InputCDR::to_octet(len))) {\n" <<
+        indent << "  throw std::runtime_error(\"WChar '" << fieldName <<
+        "' length could not be deserialized\");\n" <<
+        indent << "}\n" <<
+        indent << "if (!ser.skip(static_cast<ACE_UINT16>(len))) {\n" <<
+        indent << "  throw std::runtime_error(\"WChar '" << fieldName <<
+        "' contents could not be skipped\");\n" <<
+        indent << "}\n";
+    } else if (cls & CL_SCALAR) {
+      be_global->impl_ <<
+        indent << "if (!ser.skip(1, " << size << ")) {\n" <<
+        indent << "  throw std::runtime_error(\"Field '" << fieldName <<
+        "' could not be skipped\");\n" <<
+        indent << "}\n";
+    } else { // struct, array, sequence, union:
+      std::string pre, post;
+      if (!use_cxx11 && (cls & CL_ARRAY)) {
+        post = "_forany";
+      } else if (use_cxx11 && (cls & (CL_ARRAY | CL_SEQUENCE))) {
+        pre = "IDL::DistinctType<";
+        post = ", " + dds_generator::scoped_helper(type->name(), "_") + "_tag>";
+      }
+      be_global->impl_ <<
+        indent << "if (!gen_skip_over(ser, static_cast<" << pre << cxx_type
+        << post << "*>(0))) {\n" <<
+        indent << "  throw std::runtime_error(\"Field '" << fieldName <<
+        "' could not be skipped\");\n" <<
+        indent << "}\n";
+    }
+  }
+
+  void gen_field_getValueFromSerialized(AST_Field* field)
+  {
     AST_Type* type = field->field_type();
     const Classification cls = classify(type);
     const std::string fieldName = field->local_name()->get_string();
@@ -191,53 +253,13 @@ namespace {
         "      }\n"
         "      return val;\n"
         "    } else {\n";
-      if (cls & CL_STRING) {
-        be_global->impl_ <<
-          "      ACE_CDR::ULong len;\n"
-          "      if (!(ser >> len)) {\n"
-          "        throw std::runtime_error(\"String '" << fieldName <<
-          "' length could not be deserialized\");\n"
-          "      }\n"
-          "      if (!ser.skip(static_cast<ACE_UINT16>(len))) {\n"
-          "        throw std::runtime_error(\"String '" << fieldName <<
-          "' contents could not be skipped\");\n"
-          "      }\n";
-      } else if (cls & CL_WIDE) {
-        be_global->impl_ <<
-          "      ACE_CDR::Octet len;\n"
-          "      if (!(ser >> ACE_InputCDR::to_octet(len))) {\n"
-          "        throw std::runtime_error(\"WChar '" << fieldName <<
-          "' length could not be deserialized\");\n"
-          "      }\n"
-          "      if (!ser.skip(static_cast<ACE_UINT16>(len))) {\n"
-          "        throw std::runtime_error(\"WChar '" << fieldName <<
-          "' contents could not be skipped\");\n"
-          "      }\n";
-      } else {
-        be_global->impl_ <<
-          "      if (!ser.skip(1, " << size << ")) {\n"
-          "        throw std::runtime_error(\"Field '" << fieldName <<
-          "' could not be skipped\");\n"
-          "      }\n";
-      }
+      gen_skip_field(field, "      ");
       be_global->impl_ <<
         "    }\n";
     } else if (cls & CL_STRUCTURE) {
       delegateToNested(fieldName, field, "ser", true);
     } else { // array, sequence, union:
-      std::string pre, post;
-      if (!use_cxx11 && (cls & CL_ARRAY)) {
-        post = "_forany";
-      } else if (use_cxx11 && (cls & (CL_ARRAY | CL_SEQUENCE))) {
-        pre = "IDL::DistinctType<";
-        post = ", " + dds_generator::scoped_helper(type->name(), "_") + "_tag>";
-      }
-      be_global->impl_ <<
-        "    if (!gen_skip_over(ser, static_cast<" << pre << cxx_type << post
-        << "*>(0))) {\n"
-        "      throw std::runtime_error(\"Field \" + OPENDDS_STRING(field) + \""
-        " could not be skipped\");\n"
-        "    }\n";
+      gen_skip_field(field, "    ");
     }
   }
 
@@ -380,6 +402,212 @@ namespace {
     }
     be_global->impl_ << "    return false;\n";
   }
+
+  /// A scalar field that can be accessed by id, either a member of the
+  /// struct or a scalar field of a nested struct member ("a.b").
+  struct FieldLeaf {
+    std::string spec;
+    /// Expression naming the member relative to the struct, without the
+    /// final accessor parentheses of the C++11 mapping.
+    std::string member;
+    AST_Type* type;
+    /// Index of the member of the struct that holds the field.
+    size_t top;
+    /// For a field of a nested struct, the struct and its id there.
+    std::string nested;
+    size_t nested_id;
+  };
+
+  /// Field ids are the indexes in the vector built by this function, so a
+  /// nested struct gives its fields the same ids in its own MetaStruct.
+  void collect_leaves(const std::vector<AST_Field*>& fields,
+                      std::vector<FieldLeaf>& leaves)
+  {
+    const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
+    for (size_t i = 0; i < fields.size(); ++i) {
+      AST_Type* type = fields[i]->field_type();
+      const Classification cls = classify(type);
+      const std::string fieldName = fields[i]->local_name()->get_string();
+      if (cls & CL_SCALAR) {
+        const FieldLeaf leaf = {fieldName, fieldName, type, i, "", 0};
+        leaves.push_back(leaf);
+      } else if (cls & CL_STRUCTURE) {
+        AST_Structure* nested =
+          dynamic_cast<AST_Structure*>(resolveActualType(type));
+        std::vector<AST_Field*> nested_fields;
+        for (unsigned long j = 0; j < nested->nfields(); ++j) {
+          AST_Field** f;
+          nested->field(f, j);
+          nested_fields.push_back(*f);
+        }
+        std::vector<FieldLeaf> nested_leaves;
+        collect_leaves(nested_fields, nested_leaves);
+        for (size_t j = 0; j < nested_leaves.size(); ++j) {
+          const FieldLeaf leaf = {fieldName + "." + nested_leaves[j].spec,
+            fieldName + (use_cxx11 ? "()." : ".") + nested_leaves[j].member,
+            nested_leaves[j].type, i, scoped(type->name()), j};
+          leaves.push_back(leaf);
+        }
+      }
+    }
+  }
+
+  /// Adds the size of 'type' in an unaligned CDR stream to 'size', returns
+  /// false if it depends on the value.
+  bool fixed_unaligned_size(AST_Type* type, size_t& size)
+  {
+    type = resolveActualType(type);
+    const Classification cls = classify(type);
+    if (cls & CL_ENUM) {
+      size += 4;
+      return true;
+    }
+    if ((cls & CL_PRIMITIVE) && !(cls & CL_WIDE)) {
+      int sz = 0;
+      to_cxx_type(type, sz);
+      size += sz;
+      return true;
+    }
+    if (cls & CL_STRUCTURE) {
+      AST_Structure* struct_node = dynamic_cast<AST_Structure*>(type);
+      for (unsigned long i = 0; i < struct_node->nfields(); ++i) {
+        AST_Field** f;
+        struct_node->field(f, i);
+        if (!fixed_unaligned_size((*f)->field_type(), size)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if (cls & CL_ARRAY) {
+      AST_Array* arr = AST_Array::narrow_from_decl(type);
+      size_t elem_size = 0;
+      if (!fixed_unaligned_size(arr->base_type(), elem_size)) {
+        return false;
+      }
+      for (size_t i = 0; i < arr->n_dims(); ++i) {
+        elem_size *= arr->dims()[i]->ev()->u.ulval;
+      }
+      size += elem_size;
+      return true;
+    }
+    return false;
+  }
+
+  void gen_field_ids(const std::string& clazz,
+                     const std::vector<AST_Field*>& fields)
+  {
+    std::vector<FieldLeaf> leaves;
+    collect_leaves(fields, leaves);
+    const std::string exception =
+      "    throw std::runtime_error(\"Field id not valid for struct " + clazz
+      + "\");\n";
+
+    be_global->impl_ <<
+      "  int getFieldId(const char* field) const\n"
+      "  {\n";
+    for (size_t i = 0; i < leaves.size(); ++i) {
+      be_global->impl_ <<
+        "    if (std::strcmp(field, \"" << leaves[i].spec << "\") == 0) {\n"
+        "      return " << i << ";\n"
+        "    }\n";
+    }
+    if (leaves.empty()) {
+      be_global->impl_ << "    ACE_UNUSED_ARG(field);\n";
+    } else {
+      be_global->add_include("<cstring>", BE_GlobalData::STREAM_CPP);
+    }
+    be_global->impl_ <<
+      "    return -1;\n"
+      "  }\n\n"
+      "  Value getValueById(const void* stru, int id) const\n"
+      "  {\n"
+      "    const T& typed = *static_cast<const T*>(stru);\n"
+      "    switch (id) {\n";
+    for (size_t i = 0; i < leaves.size(); ++i) {
+      be_global->impl_ <<
+        "    case " << i << ":\n"
+        "      return " << scalar_value(leaves[i].type, "typed." + leaves[i].member)
+        << ";\n";
+    }
+    be_global->impl_ <<
+      "    }\n"
+      "    ACE_UNUSED_ARG(typed);\n" <<
+      exception <<
+      "  }\n\n"
+      "  Value getValueById(Serializer& ser, int id) const\n"
+      "  {\n"
+      "    switch (id) {\n";
+    for (size_t i = 0; i < leaves.size(); ++i) {
+      be_global->impl_ <<
+        "    case " << i << ": {\n"
+        "      skipFields(ser, " << leaves[i].top << ");\n";
+      if (leaves[i].nested.empty()) {
+        AST_Type* type = leaves[i].type;
+        const Classification cls = classify(type);
+        int size = 0;
+        const std::string cxx_type = to_cxx_type(type, size);
+        const std::string val = (cls & CL_STRING) ? "val.out()"
+          : getWrapper("val", resolveActualType(type), WD_INPUT);
+        be_global->impl_ <<
+          "      " << cxx_type << " val;\n"
+          "      if (!(ser >> " << val << ")) {\n"
+          "        throw std::runtime_error(\"Field '" << leaves[i].spec
+          << "' could not be deserialized\");\n"
+          "      }\n"
+          "      return val;\n";
+      } else {
+        be_global->impl_ <<
+          "      return getMetaStruct<" << leaves[i].nested
+          << ">().getValueById(ser, " << leaves[i].nested_id << ");\n";
+      }
+      be_global->impl_ <<
+        "    }\n";
+    }
+    be_global->impl_ <<
+      "    }\n" <<
+      exception <<
+      "  }\n\n";
+
+    // Members before the first one whose size varies are at a fixed offset
+    // when the stream isn't aligned, so they are skipped all at once.
+    std::ostringstream offsets;
+    size_t n_offsets = 0, offset = 0;
+    for (; n_offsets <= fields.size() && offset <= ACE_UINT16_MAX; ++n_offsets) {
+      offsets << (n_offsets ? ", " : "") << offset;
+      if (n_offsets == fields.size()
+          || !fixed_unaligned_size(fields[n_offsets]->field_type(), offset)) {
+        ++n_offsets;
+        break;
+      }
+    }
+    be_global->impl_ <<
+      "  /// Skip over the first 'n' members of the struct.\n"
+      "  void skipFields(Serializer& ser, size_t n) const\n"
+      "  {\n"
+      "    static const size_t offsets[] = {" << offsets.str() << "};\n"
+      "    if (n < " << n_offsets << " && ser.alignment() == Serializer::ALIGN_NONE) {\n"
+      "      if (!ser.skip(static_cast<ACE_CDR::UShort>(offsets[n]))) {\n"
+      "        throw std::runtime_error(\"Fields could not be skipped (in struct "
+      << clazz << ")\");\n"
+      "      }\n"
+      "      return;\n"
+      "    }\n"
+      "    for (size_t i = 0; i < n; ++i) {\n"
+      "      switch (i) {\n";
+    for (size_t i = 0; i < fields.size(); ++i) {
+      be_global->impl_ <<
+        "      case " << i << ": {\n";
+      gen_skip_field(fields[i], "        ");
+      be_global->impl_ <<
+        "        break;\n"
+        "      }\n";
+    }
+    be_global->impl_ <<
+      "      }\n"
+      "    }\n"
+      "  }\n\n";
+  }
 }
 
 bool metaclass_generator::gen_struct(AST_Structure*, UTL_ScopedName* name,
@@ -493,7 +721,9 @@ bool metaclass_generator::gen_struct(AST_Structure*, UTL_ScopedName* name,
   std::for_each(fields.begin(), fields.end(), compare_field);
   be_global->impl_ <<
     exception <<
-    "  }\n"
+    "  }\n\n";
+  gen_field_ids(clazz, fields);
+  be_global->impl_ <<
     "};\n\n"
     "template<>\n"
     << decl << "\n"
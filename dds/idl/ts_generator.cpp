@@ -17,6 +17,7 @@
 #include <sstream>
 #include <map>
 #include <iostream>
+#include <algorithm>
 
 namespace {
   std::string read_template(const char* prefix)
@@ -255,8 +256,713 @@ bool ts_generator::gen_union(AST_Union*, UTL_ScopedName* name,
 
 namespace java_ts_generator {
 
+  namespace {
+    using namespace AstTypeClassification;
+
+    /// Types that the Java sample codec handles: the CDR encodings of wide
+    /// characters, long double, unions and multidimensional arrays are not
+    /// generated in Java.
+    bool codec_supported(AST_Type* type)
+    {
+      type = resolveActualType(type);
+      const Classification cls = classify(type);
+      if (cls & CL_WIDE) {
+        return false;
+      }
+      if (cls & CL_PRIMITIVE) {
+        return AST_PredefinedType::narrow_from_decl(type)->pt()
+          != AST_PredefinedType::PT_longdouble;
+      }
+      if (cls & (CL_STRING | CL_ENUM)) {
+        return true;
+      }
+      if (cls & CL_STRUCTURE) {
+        AST_Structure* s = AST_Structure::narrow_from_decl(type);
+        for (unsigned long i = 0; i < s->nfields(); ++i) {
+          AST_Field** f;
+          s->field(f, i);
+          if (!codec_supported((*f)->field_type())) {
+            return false;
+          }
+        }
+        return true;
+      }
+      if (cls & CL_SEQUENCE) {
+        return codec_supported(AST_Sequence::narrow_from_decl(type)->base_type());
+      }
+      if (cls & CL_ARRAY) {
+        AST_Array* arr = AST_Array::narrow_from_decl(type);
+        return arr->n_dims() == 1 && codec_supported(arr->base_type());
+      }
+      return false;
+    }
+
+    /// The Java type used by idl2jni for 'type'
+    std::string java_type(AST_Type* type)
+    {
+      type = resolveActualType(type);
+      const Classification cls = classify(type);
+      if (cls & CL_PRIMITIVE) {
+        switch (AST_PredefinedType::narrow_from_decl(type)->pt()) {
+        case AST_PredefinedType::PT_boolean:
+          return "boolean";
+        case AST_PredefinedType::PT_char:
+          return "char";
+        case AST_PredefinedType::PT_octet:
+          return "byte";
+        case AST_PredefinedType::PT_short:
+        case AST_PredefinedType::PT_ushort:
+          return "short";
+        case AST_PredefinedType::PT_long:
+        case AST_PredefinedType::PT_ulong:
+          return "int";
+        case AST_PredefinedType::PT_longlong:
+        case AST_PredefinedType::PT_ulonglong:
+          return "long";
+        case AST_PredefinedType::PT_float:
+          return "float";
+        default:
+          return "double";
+        }
+      }
+      if (cls & CL_STRING) {
+        return "String";
+      }
+      if (cls & CL_SEQUENCE) {
+        return java_type(AST_Sequence::narrow_from_decl(type)->base_type()) + "[]";
+      }
+      if (cls & CL_ARRAY) {
+        return java_type(AST_Array::narrow_from_decl(type)->base_type()) + "[]";
+      }
+      return dds_generator::scoped_helper(type->name(), ".");
+    }
+
+    /// "new T[n]" for an array with elements of Java type 'elem'
+    std::string new_array(const std::string& elem, const std::string& n)
+    {
+      const size_t bracket = elem.find('[');
+      if (bracket == std::string::npos) {
+        return "new " + elem + '[' + n + ']';
+      }
+      return "new " + elem.substr(0, bracket) + '[' + n + ']'
+        + elem.substr(bracket);
+    }
+
+    /// For primitives that are read and written with ByteBuffer's typed
+    /// accessors, sets the accessor's suffix and the CDR size.
+    bool buffer_accessor(AST_Type* type, std::string& suffix, int& size)
+    {
+      type = resolveActualType(type);
+      if (!(classify(type) & CL_PRIMITIVE)) {
+        return false;
+      }
+      switch (AST_PredefinedType::narrow_from_decl(type)->pt()) {
+      case AST_PredefinedType::PT_octet:
+        suffix = "";
+        size = 1;
+        return true;
+      case AST_PredefinedType::PT_short:
+      case AST_PredefinedType::PT_ushort:
+        suffix = "Short";
+        size = 2;
+        return true;
+      case AST_PredefinedType::PT_long:
+      case AST_PredefinedType::PT_ulong:
+        suffix = "Int";
+        size = 4;
+        return true;
+      case AST_PredefinedType::PT_longlong:
+      case AST_PredefinedType::PT_ulonglong:
+        suffix = "Long";
+        size = 8;
+        return true;
+      case AST_PredefinedType::PT_float:
+        suffix = "Float";
+        size = 4;
+        return true;
+      case AST_PredefinedType::PT_double:
+        suffix = "Double";
+        size = 8;
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    std::string codec_method(AST_Type* type)
+    {
+      return dds_generator::scoped_helper(type->name(), "_");
+    }
+
+    std::string to_string(int i)
+    {
+      std::ostringstream oss;
+      oss << i;
+      return oss.str();
+    }
+
+    void gen_read(std::ostream& java, AST_Type* type, const std::string& lhs,
+                  const std::string& indent, int depth)
+    {
+      type = resolveActualType(type);
+      const Classification cls = classify(type);
+      std::string suffix;
+      int size = 0;
+      if (buffer_accessor(type, suffix, size)) {
+        if (size > 1) {
+          java << indent << "align(" << size << ");\n";
+        }
+        java << indent << lhs << " = buf.get" << suffix << "();\n";
+      } else if (cls & CL_PRIMITIVE) {
+        const bool boolean = AST_PredefinedType::narrow_from_decl(type)->pt()
+          == AST_PredefinedType::PT_boolean;
+        java << indent << lhs << " = "
+          << (boolean ? "buf.get() != 0" : "(char) (buf.get() & 0xff)") << ";\n";
+      } else if (cls & CL_STRING) {
+        java << indent << lhs << " = readString(" << lhs << ");\n";
+      } else if (cls & CL_ENUM) {
+        java <<
+          indent << "align(4);\n" <<
+          indent << lhs << " = " << java_type(type) << ".from_int(buf.getInt());\n";
+      } else if (cls & CL_STRUCTURE) {
+        java << indent << lhs << " = read_" << codec_method(type) << '(' << lhs
+          << ");\n";
+      } else { // sequence or array
+        const std::string n = "n" + to_string(depth), i = "i" + to_string(depth);
+        AST_Type* elem;
+        java << indent << "{\n";
+        if (cls & CL_SEQUENCE) {
+          elem = AST_Sequence::narrow_from_decl(type)->base_type();
+          java <<
+            indent << "  align(4);\n" <<
+            indent << "  final int " << n << " = buf.getInt();\n";
+        } else {
+          AST_Array* arr = AST_Array::narrow_from_decl(type);
+          elem = arr->base_type();
+          java << indent << "  final int " << n << " = "
+            << arr->dims()[0]->ev()->u.ulval << ";\n";
+        }
+        java <<
+          indent << "  if (" << lhs << " == null || " << lhs << ".length != " << n
+          << ") {\n" <<
+          indent << "    " << lhs << " = " << new_array(java_type(elem), n) << ";\n" <<
+          indent << "  }\n";
+        if (buffer_accessor(elem, suffix, size) && size == 1) {
+          java << indent << "  buf.get(" << lhs << ", 0, " << n << ");\n";
+        } else if (buffer_accessor(elem, suffix, size)) {
+          // no alignment is written for an empty sequence
+          java <<
+            indent << "  if (" << n << " > 0) {\n" <<
+            indent << "    align(" << size << ");\n" <<
+            indent << "  }\n" <<
+            indent << "  for (int " << i << " = 0; " << i << " < " << n << "; ++"
+            << i << ") {\n" <<
+            indent << "    " << lhs << '[' << i << "] = buf.get" << suffix
+            << "();\n" <<
+            indent << "  }\n";
+        } else {
+          java << indent << "  for (int " << i << " = 0; " << i << " < " << n
+            << "; ++" << i << ") {\n";
+          gen_read(java, elem, lhs + '[' + i + ']', indent + "    ", depth + 1);
+          java << indent << "  }\n";
+        }
+        java << indent << "}\n";
+      }
+    }
+
+    void gen_write(std::ostream& java, AST_Type* type, const std::string& rhs,
+                   const std::string& indent, int depth)
+    {
+      type = resolveActualType(type);
+      const Classification cls = classify(type);
+      std::string suffix;
+      int size = 0;
+      if (buffer_accessor(type, suffix, size)) {
+        if (size > 1) {
+          java << indent << "align(" << size << ");\n";
+        }
+        java << indent << "buf.put" << suffix << '(' << rhs << ");\n";
+      } else if (cls & CL_PRIMITIVE) {
+        const bool boolean = AST_PredefinedType::narrow_from_decl(type)->pt()
+          == AST_PredefinedType::PT_boolean;
+        java << indent << "buf.put((byte) "
+          << (boolean ? "(" + rhs + " ? 1 : 0)" : rhs) << ");\n";
+      } else if (cls & CL_STRING) {
+        java << indent << "writeString(" << rhs << ");\n";
+      } else if (cls & CL_ENUM) {
+        java <<
+          indent << "align(4);\n" <<
+          indent << "buf.putInt(" << rhs << ".value());\n";
+      } else if (cls & CL_STRUCTURE) {
+        java << indent << "write_" << codec_method(type) << '(' << rhs << ");\n";
+      } else { // sequence or array
+        const std::string n = "n" + to_string(depth), i = "i" + to_string(depth),
+          a = "a" + to_string(depth);
+        AST_Type* elem;
+        java <<
+          indent << "{\n" <<
+          indent << "  final " << java_type(type) << ' ' << a << " = " << rhs
+          << ";\n";
+        if (cls & CL_SEQUENCE) {
+          elem = AST_Sequence::narrow_from_decl(type)->base_type();
+          java <<
+            indent << "  final int " << n << " = " << a << " == null ? 0 : " << a
+            << ".length;\n" <<
+            indent << "  align(4);\n" <<
+            indent << "  buf.putInt(" << n << ");\n";
+        } else {
+          AST_Array* arr = AST_Array::narrow_from_decl(type);
+          elem = arr->base_type();
+          java << indent << "  final int " << n << " = "
+            << arr->dims()[0]->ev()->u.ulval << ";\n";
+        }
+        if (buffer_accessor(elem, suffix, size) && size == 1) {
+          java <<
+            indent << "  if (" << n << " > 0) {\n" <<
+            indent << "    buf.put(" << a << ", 0, " << n << ");\n" <<
+            indent << "  }\n";
+        } else if (buffer_accessor(elem, suffix, size)) {
+          java <<
+            indent << "  if (" << n << " > 0) {\n" <<
+            indent << "    align(" << size << ");\n" <<
+            indent << "  }\n" <<
+            indent << "  for (int " << i << " = 0; " << i << " < " << n << "; ++"
+            << i << ") {\n" <<
+            indent << "    buf.put" << suffix << '(' << a << '[' << i << "]);\n" <<
+            indent << "  }\n";
+        } else {
+          java << indent << "  for (int " << i << " = 0; " << i << " < " << n
+            << "; ++" << i << ") {\n";
+          gen_write(java, elem, a + '[' + i + ']', indent + "    ", depth + 1);
+          java << indent << "  }\n";
+        }
+        java << indent << "}\n";
+      }
+    }
+
+    void find_structs(AST_Type* type, std::vector<AST_Structure*>& structs)
+    {
+      type = resolveActualType(type);
+      const Classification cls = classify(type);
+      if (cls & CL_SEQUENCE) {
+        find_structs(AST_Sequence::narrow_from_decl(type)->base_type(), structs);
+      } else if (cls & CL_ARRAY) {
+        find_structs(AST_Array::narrow_from_decl(type)->base_type(), structs);
+      } else if (cls & CL_STRUCTURE) {
+        AST_Structure* s = AST_Structure::narrow_from_decl(type);
+        if (std::find(structs.begin(), structs.end(), s) != structs.end()) {
+          return;
+        }
+        structs.push_back(s);
+        for (unsigned long i = 0; i < s->nfields(); ++i) {
+          AST_Field** f;
+          s->field(f, i);
+          find_structs((*f)->field_type(), structs);
+        }
+      }
+    }
+
+    /// Java classes nested in the TypeSupportImpl that take and write
+    /// samples in batches.  Samples cross JNI in their CDR encoding (with
+    /// native byte order) in a direct ByteBuffer, which the generated Codec
+    /// converts from/to caller-owned sample objects that are reused.
+    void gen_bulk(std::ostream& java, AST_Structure* node,
+                  const std::string& clazz)
+    {
+      std::vector<AST_Structure*> structs;
+      find_structs(node, structs);
+      const std::string top = codec_method(node);
+
+      java <<
+        "\n"
+        "    /**\n"
+        "     * Takes samples from a " << clazz << "DataReader in batches.  The\n"
+        "     * samples of one take are passed from the native library in a\n"
+        "     * single direct ByteBuffer and are decoded into the objects in the\n"
+        "     * caller's arrays, which are reused from one take to the next.\n"
+        "     * Instances are not thread-safe.\n"
+        "     */\n"
+        "    public static final class BulkReader {\n"
+        "        private final " << clazz << "DataReader reader;\n"
+        "        private final Codec codec = new Codec();\n"
+        "\n"
+        "        public BulkReader(" << clazz << "DataReader reader) {\n"
+        "            this.reader = reader;\n"
+        "        }\n"
+        "\n"
+        "        /**\n"
+        "         * Takes up to max_samples samples (LENGTH_UNLIMITED for as many\n"
+        "         * as the arrays hold) into samples and infos, allocating the\n"
+        "         * elements that are null.  Returns the number of samples taken,\n"
+        "         * which is 0 if there was no data, or the negated DDS return\n"
+        "         * code if the take failed.  Samples without valid data are not\n"
+        "         * modified.\n"
+        "         */\n"
+        "        public int take(" << clazz << "[] samples, DDS.SampleInfo[] infos,\n"
+        "                        int max_samples, int sample_states,\n"
+        "                        int view_states, int instance_states) {\n"
+        "            int max = Math.min(samples.length, infos.length);\n"
+        "            if (max_samples != DDS.LENGTH_UNLIMITED.value) {\n"
+        "                max = Math.min(max, max_samples);\n"
+        "            }\n"
+        "            if (max == 0) {\n"
+        "                return 0;\n"
+        "            }\n"
+        "            final java.nio.ByteBuffer result = _take(reader, codec.buf, max,\n"
+        "                sample_states, view_states, instance_states);\n"
+        "            if (result == null) {\n"
+        "                return -DDS.RETCODE_ERROR.value;\n"
+        "            }\n"
+        "            final java.nio.ByteBuffer buf = codec.buf =\n"
+        "                result.order(java.nio.ByteOrder.nativeOrder());\n"
+        "            final int ret = buf.getInt(0);\n"
+        "            if (ret != DDS.RETCODE_OK.value) {\n"
+        "                return ret == DDS.RETCODE_NO_DATA.value ? 0 : -ret;\n"
+        "            }\n"
+        "            final int n = buf.getInt(4);\n"
+        "            int pos = HEADER_SIZE;\n"
+        "            for (int i = 0; i < n; ++i) {\n"
+        "                pos = (pos + 7) & ~7;\n"
+        "                if (infos[i] == null) {\n"
+        "                    infos[i] = new DDS.SampleInfo();\n"
+        "                }\n"
+        "                final DDS.SampleInfo si = infos[i];\n"
+        "                if (si.source_timestamp == null) {\n"
+        "                    si.source_timestamp = new DDS.Time_t();\n"
+        "                }\n"
+        "                si.valid_data = buf.getInt(pos) != 0;\n"
+        "                si.sample_state = buf.getInt(pos + 4);\n"
+        "                si.view_state = buf.getInt(pos + 8);\n"
+        "                si.instance_state = buf.getInt(pos + 12);\n"
+        "                si.instance_handle = buf.getInt(pos + 16);\n"
+        "                si.publication_handle = buf.getInt(pos + 20);\n"
+        "                si.source_timestamp.sec = buf.getInt(pos + 24);\n"
+        "                si.source_timestamp.nanosec = buf.getInt(pos + 28);\n"
+        "                si.disposed_generation_count = buf.getInt(pos + 32);\n"
+        "                si.no_writers_generation_count = buf.getInt(pos + 36);\n"
+        "                si.sample_rank = buf.getInt(pos + 40);\n"
+        "                si.generation_rank = buf.getInt(pos + 44);\n"
+        "                si.absolute_generation_rank = buf.getInt(pos + 48);\n"
+        "                final int length = buf.getInt(pos + 52);\n"
+        "                pos += INFO_SIZE;\n"
+        "                if (si.valid_data) {\n"
+        "                    codec.begin(pos);\n"
+        "                    samples[i] = codec.read_" << top << "(samples[i]);\n"
+        "                }\n"
+        "                pos += length;\n"
+        "            }\n"
+        "            return n;\n"
+        "        }\n"
+        "\n"
+        "        private static native java.nio.ByteBuffer _take(\n"
+        "            " << clazz << "DataReader reader, java.nio.ByteBuffer buf,\n"
+        "            int max_samples, int sample_states, int view_states,\n"
+        "            int instance_states);\n"
+        "    }\n"
+        "\n"
+        "    /**\n"
+        "     * Writes samples to a " << clazz << "DataWriter in batches.  The\n"
+        "     * samples of one write are encoded into a single direct\n"
+        "     * ByteBuffer and passed to the native library in one call.\n"
+        "     * Instances are not thread-safe.\n"
+        "     */\n"
+        "    public static final class BulkWriter {\n"
+        "        private final " << clazz << "DataWriter writer;\n"
+        "        private final Codec codec = new Codec();\n"
+        "\n"
+        "        public BulkWriter(" << clazz << "DataWriter writer) {\n"
+        "            this.writer = writer;\n"
+        "        }\n"
+        "\n"
+        "        /**\n"
+        "         * Writes the first count samples, as write(sample, HANDLE_NIL)\n"
+        "         * would.  Returns RETCODE_OK or the return code of the first\n"
+        "         * write that failed, in which case the later samples are not\n"
+        "         * written.\n"
+        "         */\n"
+        "        public int write(" << clazz << "[] samples, int count) {\n"
+        "            while (true) {\n"
+        "                try {\n"
+        "                    int pos = 0;\n"
+        "                    for (int i = 0; i < count; ++i) {\n"
+        "                        pos = (pos + 7) & ~7;\n"
+        "                        codec.begin(pos + 8);\n"
+        "                        codec.write_" << top << "(samples[i]);\n"
+        "                        codec.buf.putInt(pos, codec.buf.position() - pos - 8);\n"
+        "                        pos = codec.buf.position();\n"
+        "                    }\n"
+        "                    return _write(writer, codec.buf, count);\n"
+        "                } catch (java.nio.BufferOverflowException e) {\n"
+        "                    codec.grow();\n"
+        "                }\n"
+        "            }\n"
+        "        }\n"
+        "\n"
+        "        private static native int _write(" << clazz << "DataWriter writer,\n"
+        "            java.nio.ByteBuffer buf, int count);\n"
+        "    }\n"
+        "\n"
+        "    /** Bytes before the first sample in a BulkReader's buffer */\n"
+        "    private static final int HEADER_SIZE = 8;\n"
+        "    /** Bytes of SampleInfo before each sample in a BulkReader's buffer */\n"
+        "    private static final int INFO_SIZE = 56;\n"
+        "\n"
+        "    /** Converts between samples and their CDR encoding. */\n"
+        "    private static final class Codec {\n"
+        "        private static final java.nio.charset.Charset UTF8 =\n"
+        "            java.nio.charset.Charset.forName(\"UTF-8\");\n"
+        "        java.nio.ByteBuffer buf = java.nio.ByteBuffer.allocateDirect(65536)\n"
+        "            .order(java.nio.ByteOrder.nativeOrder());\n"
+        "        private int base;\n"
+        "        private byte[] scratch = new byte[256];\n"
+        "\n"
+        "        void grow() {\n"
+        "            buf = java.nio.ByteBuffer.allocateDirect(buf.capacity() * 2)\n"
+        "                .order(java.nio.ByteOrder.nativeOrder());\n"
+        "        }\n"
+        "\n"
+        "        /** Starts encoding or decoding a sample at 'pos' */\n"
+        "        void begin(int pos) {\n"
+        "            if (pos > buf.capacity()) {\n"
+        "                throw new java.nio.BufferOverflowException();\n"
+        "            }\n"
+        "            buf.limit(buf.capacity());\n"
+        "            buf.position(pos);\n"
+        "            base = pos;\n"
+        "        }\n"
+        "\n"
+        "        private void align(int n) {\n"
+        "            final int pad = (n - (buf.position() - base) % n) % n;\n"
+        "            if (pad != 0) {\n"
+        "                if (buf.position() + pad > buf.limit()) {\n"
+        "                    throw new java.nio.BufferOverflowException();\n"
+        "                }\n"
+        "                buf.position(buf.position() + pad);\n"
+        "            }\n"
+        "        }\n"
+        "\n"
+        "        /** Returns 'old' if the encoded string is equal to it */\n"
+        "        private String readString(String old) {\n"
+        "            align(4);\n"
+        "            final int len = Math.max(buf.getInt() - 1, 0); // without nul\n"
+        "            final int start = buf.position();\n"
+        "            if (old != null && old.length() == len) {\n"
+        "                int i = 0;\n"
+        "                for (; i < len; ++i) {\n"
+        "                    final byte b = buf.get(start + i);\n"
+        "                    if (b < 0 || old.charAt(i) != b) {\n"
+        "                        break;\n"
+        "                    }\n"
+        "                }\n"
+        "                if (i == len) {\n"
+        "                    buf.position(start + len + 1);\n"
+        "                    return old;\n"
+        "                }\n"
+        "            }\n"
+        "            if (scratch.length < len) {\n"
+        "                scratch = new byte[len];\n"
+        "            }\n"
+        "            buf.get(scratch, 0, len);\n"
+        "            buf.position(start + len + 1);\n"
+        "            return new String(scratch, 0, len, UTF8);\n"
+        "        }\n"
+        "\n"
+        "        private void writeString(String s) {\n"
+        "            if (s == null) {\n"
+        "                s = \"\";\n"
+        "            }\n"
+        "            final int len = s.length();\n"
+        "            int ascii = 0;\n"
+        "            while (ascii < len && s.charAt(ascii) < 0x80) {\n"
+        "                ++ascii;\n"
+        "            }\n"
+        "            align(4);\n"
+        "            if (ascii == len) {\n"
+        "                buf.putInt(len + 1);\n"
+        "                for (int i = 0; i < len; ++i) {\n"
+        "                    buf.put((byte) s.charAt(i));\n"
+        "                }\n"
+        "            } else {\n"
+        "                final byte[] bytes = s.getBytes(UTF8);\n"
+        "                buf.putInt(bytes.length + 1);\n"
+        "                buf.put(bytes);\n"
+        "            }\n"
+        "            buf.put((byte) 0);\n"
+        "        }\n";
+
+      for (size_t i = 0; i < structs.size(); ++i) {
+        AST_Structure* s = structs[i];
+        const std::string jtype = java_type(s), method = codec_method(s);
+        java <<
+          "\n"
+          "        " << jtype << " read_" << method << '(' << jtype << " s) {\n"
+          "            if (s == null) {\n"
+          "                s = new " << jtype << "();\n"
+          "            }\n";
+        for (unsigned long j = 0; j < s->nfields(); ++j) {
+          AST_Field** f;
+          s->field(f, j);
+          gen_read(java, (*f)->field_type(),
+                   std::string("s.") + (*f)->local_name()->get_string(),
+                   "            ", 0);
+        }
+        java <<
+          "            return s;\n"
+          "        }\n"
+          "\n"
+          "        void write_" << method << '(' << jtype << " s) {\n";
+        for (unsigned long j = 0; j < s->nfields(); ++j) {
+          AST_Field** f;
+          s->field(f, j);
+          gen_write(java, (*f)->field_type(),
+                    std::string("s.") + (*f)->local_name()->get_string(),
+                    "            ", 0);
+        }
+        java <<
+          "        }\n";
+      }
+      java <<
+        "    }\n";
+    }
+
+    /// Native methods of the classes generated by gen_bulk.
+    void gen_bulk_jni(const std::string& type, const std::string& jniclass)
+    {
+      const std::string seq = type + be_global->sequence_suffix().c_str();
+      be_global->add_include("idl2jni_runtime.h", BE_GlobalData::STREAM_CPP);
+      be_global->impl_ <<
+        "// Each sample taken is written at the next 8-byte boundary after the\n"
+        "// 8-byte header (return code, number of samples) as its SampleInfo\n"
+        "// (14 jints, the last being the length of the encoding) followed by its\n"
+        "// CDR encoding.\n"
+        "extern \"C\" JNIEXPORT jobject JNICALL\n"
+        "Java_" << jniclass << "TypeSupportImpl_00024BulkReader__1take(JNIEnv* jni,\n"
+        "  jclass, jobject jreader, jobject jbuf, jint max_samples,\n"
+        "  jint sample_states, jint view_states, jint instance_states)\n"
+        "{\n"
+        "  try {\n"
+        "    " << type << "DataReader_var reader =\n"
+        "      " << type << "DataReader::_narrow(recoverTaoObject(jni, jreader));\n"
+        "    jint* header = static_cast<jint*>(jni->GetDirectBufferAddress(jbuf));\n"
+        "    if (CORBA::is_nil(reader.in()) || !header) {\n"
+        "      return 0;\n"
+        "    }\n"
+        "    " << seq << " data;\n"
+        "    ::DDS::SampleInfoSeq info;\n"
+        "    const ::DDS::ReturnCode_t ret = reader->take(data, info, max_samples,\n"
+        "      sample_states, view_states, instance_states);\n"
+        "    if (ret != ::DDS::RETCODE_OK) {\n"
+        "      header[0] = ret;\n"
+        "      header[1] = 0;\n"
+        "      return jbuf;\n"
+        "    }\n"
+        "    size_t needed = 8;\n"
+        "    for (CORBA::ULong i = 0; i < data.length(); ++i) {\n"
+        "      size_t size = 0, padding = 0;\n"
+        "      if (info[i].valid_data) {\n"
+        "        OpenDDS::DCPS::gen_find_size(data[i], size, padding);\n"
+        "      }\n"
+        "      needed = ((needed + 7) & ~size_t(7)) + 56 + size + padding;\n"
+        "    }\n"
+        "    if (jni->GetDirectBufferCapacity(jbuf) < jlong(needed)) {\n"
+        "      const jclass bb = jni->FindClass(\"java/nio/ByteBuffer\");\n"
+        "      const jmethodID allocate = jni->GetStaticMethodID(bb,\n"
+        "        \"allocateDirect\", \"(I)Ljava/nio/ByteBuffer;\");\n"
+        "      jbuf = jni->CallStaticObjectMethod(bb, allocate,\n"
+        "        jint(needed + needed / 2));\n"
+        "      if (jni->ExceptionCheck()) {\n"
+        "        reader->return_loan(data, info);\n"
+        "        return 0;\n"
+        "      }\n"
+        "      header = static_cast<jint*>(jni->GetDirectBufferAddress(jbuf));\n"
+        "    }\n"
+        "    char* const buf = reinterpret_cast<char*>(header);\n"
+        "    header[0] = ::DDS::RETCODE_OK;\n"
+        "    header[1] = jint(data.length());\n"
+        "    size_t pos = 8;\n"
+        "    for (CORBA::ULong i = 0; i < data.length(); ++i) {\n"
+        "      pos = (pos + 7) & ~size_t(7);\n"
+        "      jint* const si = reinterpret_cast<jint*>(buf + pos);\n"
+        "      si[0] = info[i].valid_data;\n"
+        "      si[1] = info[i].sample_state;\n"
+        "      si[2] = info[i].view_state;\n"
+        "      si[3] = info[i].instance_state;\n"
+        "      si[4] = info[i].instance_handle;\n"
+        "      si[5] = info[i].publication_handle;\n"
+        "      si[6] = info[i].source_timestamp.sec;\n"
+        "      si[7] = info[i].source_timestamp.nanosec;\n"
+        "      si[8] = info[i].disposed_generation_count;\n"
+        "      si[9] = info[i].no_writers_generation_count;\n"
+        "      si[10] = info[i].sample_rank;\n"
+        "      si[11] = info[i].generation_rank;\n"
+        "      si[12] = info[i].absolute_generation_rank;\n"
+        "      si[13] = 0;\n"
+        "      pos += 56;\n"
+        "      if (info[i].valid_data) {\n"
+        "        size_t size = 0, padding = 0;\n"
+        "        OpenDDS::DCPS::gen_find_size(data[i], size, padding);\n"
+        "        ACE_Message_Block mb(buf + pos, size + padding);\n"
+        "        OpenDDS::DCPS::Serializer ser(&mb, false,\n"
+        "          OpenDDS::DCPS::Serializer::ALIGN_CDR);\n"
+        "        if (!(ser << data[i])) {\n"
+        "          header[0] = ::DDS::RETCODE_ERROR;\n"
+        "          break;\n"
+        "        }\n"
+        "        si[13] = jint(mb.length());\n"
+        "        pos += mb.length();\n"
+        "      }\n"
+        "    }\n"
+        "    reader->return_loan(data, info);\n"
+        "    return jbuf;\n"
+        "  } catch (const CORBA::SystemException& se) {\n"
+        "    throw_java_exception(jni, se);\n"
+        "  }\n"
+        "  return 0;\n"
+        "}\n\n"
+        "// Each sample to write is at the next 8-byte boundary as its length\n"
+        "// (padded to 8 bytes) followed by its CDR encoding.\n"
+        "extern \"C\" JNIEXPORT jint JNICALL\n"
+        "Java_" << jniclass << "TypeSupportImpl_00024BulkWriter__1write(JNIEnv* jni,\n"
+        "  jclass, jobject jwriter, jobject jbuf, jint count)\n"
+        "{\n"
+        "  try {\n"
+        "    " << type << "DataWriter_var writer =\n"
+        "      " << type << "DataWriter::_narrow(recoverTaoObject(jni, jwriter));\n"
+        "    char* const buf = static_cast<char*>(jni->GetDirectBufferAddress(jbuf));\n"
+        "    if (CORBA::is_nil(writer.in()) || !buf) {\n"
+        "      return ::DDS::RETCODE_BAD_PARAMETER;\n"
+        "    }\n"
+        "    " << type << " sample;\n"
+        "    size_t pos = 0;\n"
+        "    for (jint i = 0; i < count; ++i) {\n"
+        "      pos = (pos + 7) & ~size_t(7);\n"
+        "      const size_t length = *reinterpret_cast<const jint*>(buf + pos);\n"
+        "      pos += 8;\n"
+        "      ACE_Message_Block mb(buf + pos, length);\n"
+        "      mb.wr_ptr(length);\n"
+        "      OpenDDS::DCPS::Serializer ser(&mb, false,\n"
+        "        OpenDDS::DCPS::Serializer::ALIGN_CDR);\n"
+        "      if (!(ser >> sample)) {\n"
+        "        return ::DDS::RETCODE_ERROR;\n"
+        "      }\n"
+        "      const ::DDS::ReturnCode_t ret = writer->write(sample, ::DDS::HANDLE_NIL);\n"
+        "      if (ret != ::DDS::RETCODE_OK) {\n"
+        "        return ret;\n"
+        "      }\n"
+        "      pos += length;\n"
+        "    }\n"
+        "    return ::DDS::RETCODE_OK;\n"
+        "  } catch (const CORBA::SystemException& se) {\n"
+        "    throw_java_exception(jni, se);\n"
+        "  }\n"
+        "  return ::DDS::RETCODE_ERROR;\n"
+        "}\n\n";
+    }
+  }
+
   /// called directly by dds_visitor::visit_structure() if -Wb,java
-  void generate(UTL_ScopedName* name) {
+  void generate(AST_Structure* node) {
+    UTL_ScopedName* name = node->name();
     if (idl_global->is_dcps_type(name) == 0) {
       // no #pragma DCPS_DATA_TYPE, so nothing to generate
       return;
@@ -301,6 +1007,8 @@ namespace java_ts_generator {
     std::string clazz = name->last_component()->get_string();
     file += clazz + "TypeSupportImpl.java";
 
+    const bool bulk = codec_supported(node);
+
     std::ofstream java(file.c_str());
     java << (jpackage.size() ? "package " : "") << jpackage
       << (jpackage.size() ? ";\n" :"") <<
@@ -309,7 +1017,11 @@ namespace java_ts_generator {
       "    public " << clazz << "TypeSupportImpl() {\n"
       "        super(_jni_init());\n"
       "    }\n"
-      "    private static native long _jni_init();\n"
+      "    private static native long _jni_init();\n";
+    if (bulk) {
+      gen_bulk(java, node, clazz);
+    }
+    java <<
       "}\n";
     be_global->impl_ <<
       "extern \"C\" JNIEXPORT jlong JNICALL\n"
@@ -317,6 +1029,9 @@ namespace java_ts_generator {
       "  return reinterpret_cast<jlong>(static_cast<CORBA::Object_ptr>(new "
       << type << "TypeSupportImpl));\n"
       "}\n\n";
+    if (bulk) {
+      gen_bulk_jni(type, jniclass);
+    }
   }
 
 }
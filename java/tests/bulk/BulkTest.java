@@ -0,0 +1,186 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+import DDS.*;
+import OpenDDS.DCPS.*;
+import org.omg.CORBA.StringSeqHolder;
+import Messenger.*;
+
+public class BulkTest {
+    private static final int N_MSGS = 100;
+    private static final int BATCH = 16;
+
+    public static void main(String[] args) {
+        int status = 1;
+        try {
+            status = run(args);
+        } finally {
+            TheServiceParticipant.shutdown();
+        }
+        System.exit(status);
+    }
+
+    private static int run(String[] args) {
+        DomainParticipantFactory dpf =
+            TheParticipantFactory.WithArgs(new StringSeqHolder(args));
+        if (dpf == null) {
+            System.err.println("ERROR: Domain Participant Factory not found");
+            return 1;
+        }
+        DomainParticipant dp = dpf.create_participant(4,
+            PARTICIPANT_QOS_DEFAULT.get(), null, DEFAULT_STATUS_MASK.value);
+        if (dp == null) {
+            System.err.println("ERROR: Domain Participant creation failed");
+            return 1;
+        }
+
+        MessageTypeSupportImpl servant = new MessageTypeSupportImpl();
+        if (servant.register_type(dp, "") != RETCODE_OK.value) {
+            System.err.println("ERROR: register_type failed");
+            return 1;
+        }
+
+        Publisher pub = dp.create_publisher(PUBLISHER_QOS_DEFAULT.get(), null,
+                                            DEFAULT_STATUS_MASK.value);
+        Subscriber sub = dp.create_subscriber(SUBSCRIBER_QOS_DEFAULT.get(),
+                                              null, DEFAULT_STATUS_MASK.value);
+        Topic top = dp.create_topic("Movie Discussion List",
+                                    servant.get_type_name(),
+                                    TOPIC_QOS_DEFAULT.get(),
+                                    null,
+                                    DEFAULT_STATUS_MASK.value);
+        if (pub == null || sub == null || top == null) {
+            System.err.println("ERROR: Entity creation failed");
+            return 1;
+        }
+
+        DataReaderQosHolder drqos =
+            new DataReaderQosHolder(DATAREADER_QOS_DEFAULT.get());
+        sub.get_default_datareader_qos(drqos);
+        drqos.value.reliability.kind =
+            ReliabilityQosPolicyKind.RELIABLE_RELIABILITY_QOS;
+        drqos.value.history.kind = HistoryQosPolicyKind.KEEP_ALL_HISTORY_QOS;
+
+        DataWriterQosHolder dwqos =
+            new DataWriterQosHolder(DATAWRITER_QOS_DEFAULT.get());
+        pub.get_default_datawriter_qos(dwqos);
+        dwqos.value.history.kind = HistoryQosPolicyKind.KEEP_ALL_HISTORY_QOS;
+
+        DataWriter dw = pub.create_datawriter(top, dwqos.value, null,
+                                              DEFAULT_STATUS_MASK.value);
+        DataReader dr = sub.create_datareader(top, drqos.value, null,
+                                              DEFAULT_STATUS_MASK.value);
+        if (dw == null || dr == null) {
+            System.err.println("ERROR: DataWriter/DataReader creation failed");
+            return 1;
+        }
+
+        StatusCondition sc = dw.get_statuscondition();
+        sc.set_enabled_statuses(PUBLICATION_MATCHED_STATUS.value);
+        WaitSet ws = new WaitSet();
+        ws.attach_condition(sc);
+        PublicationMatchedStatusHolder matched =
+            new PublicationMatchedStatusHolder(new PublicationMatchedStatus());
+        Duration_t timeout = new Duration_t(DURATION_INFINITE_SEC.value,
+                                            DURATION_INFINITE_NSEC.value);
+        while (true) {
+            if (dw.get_publication_matched_status(matched)
+                != RETCODE_OK.value) {
+                System.err.println("ERROR: get_publication_matched_status()" +
+                                   "failed.");
+                return 1;
+            }
+            if (matched.value.current_count >= 1) {
+                break;
+            }
+            ConditionSeqHolder cond = new ConditionSeqHolder(new Condition[]{});
+            if (ws.wait(cond, timeout) != RETCODE_OK.value) {
+                System.err.println("ERROR: wait() failed.");
+                return 1;
+            }
+        }
+        ws.detach_condition(sc);
+
+        // Write in batches, reusing the sample objects
+        MessageTypeSupportImpl.BulkWriter writer =
+            new MessageTypeSupportImpl.BulkWriter(
+                MessageDataWriterHelper.narrow(dw));
+        Message[] out = new Message[BATCH];
+        for (int i = 0; i < BATCH; ++i) {
+            out[i] = new Message("OpenDDS-Java", "Review", 99,
+                                 "Worst. Movie. Ever.", 0);
+        }
+        // A non-ASCII string is encoded as UTF-8
+        out[0].text = "Pire film \u00e9ver";
+        for (int count = 0; count < N_MSGS;) {
+            int n = Math.min(BATCH, N_MSGS - count);
+            for (int i = 0; i < n; ++i) {
+                out[i].count = count + i;
+            }
+            int ret = writer.write(out, n);
+            if (ret != RETCODE_OK.value) {
+                System.err.println("ERROR: bulk write returned " + ret);
+                return 1;
+            }
+            count += n;
+        }
+
+        MessageTypeSupportImpl.BulkReader reader =
+            new MessageTypeSupportImpl.BulkReader(
+                MessageDataReaderHelper.narrow(dr));
+        ReadCondition rc = dr.create_readcondition(ANY_SAMPLE_STATE.value,
+                                                   ANY_VIEW_STATE.value,
+                                                   ANY_INSTANCE_STATE.value);
+        ws.attach_condition(rc);
+        Message[] in = new Message[BATCH];
+        SampleInfo[] infos = new SampleInfo[BATCH];
+        boolean[] received = new boolean[N_MSGS];
+        int n_received = 0;
+        while (n_received < N_MSGS) {
+            ConditionSeqHolder cond = new ConditionSeqHolder(new Condition[]{});
+            if (ws.wait(cond, timeout) != RETCODE_OK.value) {
+                System.err.println("ERROR: DataReader wait() failed.");
+                return 1;
+            }
+            int n;
+            while ((n = reader.take(in, infos, LENGTH_UNLIMITED.value,
+                                    ANY_SAMPLE_STATE.value,
+                                    ANY_VIEW_STATE.value,
+                                    ANY_INSTANCE_STATE.value)) > 0) {
+                for (int i = 0; i < n; ++i) {
+                    if (!infos[i].valid_data) {
+                        continue;
+                    }
+                    Message m = in[i];
+                    if (m.count < 0 || m.count >= N_MSGS || received[m.count]
+                        || m.subject_id != 99 || !m.from.equals("OpenDDS-Java")
+                        || !m.subject.equals("Review")
+                        || !m.text.equals(m.count % BATCH == 0
+                                          ? "Pire film \u00e9ver"
+                                          : "Worst. Movie. Ever.")) {
+                        System.err.println("ERROR: unexpected sample "
+                                           + m.count);
+                        return 1;
+                    }
+                    received[m.count] = true;
+                    ++n_received;
+                }
+            }
+            if (n < 0) {
+                System.err.println("ERROR: bulk take returned " + n);
+                return 1;
+            }
+        }
+        ws.detach_condition(rc);
+        dr.delete_readcondition(rc);
+        System.out.println("Received " + n_received + " samples");
+
+        dp.delete_contained_entities();
+        dpf.delete_participant(dp);
+        return 0;
+    }
+}
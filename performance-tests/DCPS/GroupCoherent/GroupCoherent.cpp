@@ -0,0 +1,329 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <ace/Get_Opt.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_time.h>
+#include <ace/High_Res_Timer.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/WaitSet.h>
+
+#include "dds/DCPS/StaticIncludes.h"
+
+#include "GroupCoherentTypeSupportImpl.h"
+
+#include <vector>
+
+namespace {
+
+int num_samples = 10000;
+int num_sets = 10;
+int num_writers = 2;
+int num_instances = 100;
+bool ordered = false;
+
+int
+parse_args(int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("n:s:w:i:o"));
+
+  int c;
+  while ((c = get_opts()) != -1) {
+    switch (c) {
+    case 'n':
+      num_samples = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case 's':
+      num_sets = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case 'w':
+      num_writers = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case 'i':
+      num_instances = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case 'o':
+      ordered = true;
+      break;
+    case '?':
+    default:
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("usage: %s -n <samples per set> -s <sets> ")
+                        ACE_TEXT("-w <writers> -i <instances> [-o]\n"),
+                        argv[0]),
+                       -1);
+    }
+  }
+
+  if (num_samples <= 0 || num_sets <= 0 || num_writers <= 0 || num_instances <= 0) {
+    ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: arguments must be positive\n")), -1);
+  }
+  return 0;
+}
+
+double
+usec_since(ACE_hrtime_t start)
+{
+  return static_cast<double>(ACE_OS::gethrtime() - start)
+    / ACE_High_Res_Timer::global_scale_factor();
+}
+
+bool
+wait_for_match(DDS::DataWriter_ptr dw)
+{
+  DDS::StatusCondition_var condition = dw->get_statuscondition();
+  condition->set_enabled_statuses(DDS::PUBLICATION_MATCHED_STATUS);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition);
+
+  const DDS::Duration_t timeout = {10, 0};
+  DDS::PublicationMatchedStatus matches = {0, 0, 0, 0, 0};
+  bool ok = true;
+  while (matches.current_count < 1) {
+    if (dw->get_publication_matched_status(matches) != DDS::RETCODE_OK) {
+      ok = false;
+      break;
+    }
+    if (matches.current_count >= 1) {
+      break;
+    }
+    DDS::ConditionSeq conditions;
+    if (ws->wait(conditions, timeout) != DDS::RETCODE_OK) {
+      ok = false;
+      break;
+    }
+  }
+  ws->detach_condition(condition);
+  return ok;
+}
+
+/// Take everything the subscriber's readers have, returns the number of
+/// valid samples.
+int
+take_set(const DDS::Subscriber_var& sub,
+         const std::vector<GroupCoherent::SampleDataReader_var>& readers)
+{
+  int received = 0;
+  sub->begin_access();
+  if (ordered) {
+    // With ordered_access each entry of the list yields the next sample
+    DDS::DataReaderSeq list;
+    sub->get_datareaders(list, DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                         DDS::ANY_INSTANCE_STATE);
+    for (CORBA::ULong i = 0; i < list.length(); ++i) {
+      GroupCoherent::SampleDataReader_var dr =
+        GroupCoherent::SampleDataReader::_narrow(list[i]);
+      GroupCoherent::SampleSeq data;
+      DDS::SampleInfoSeq infos;
+      if (dr->take(data, infos, 1, DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                   DDS::ANY_INSTANCE_STATE) == DDS::RETCODE_OK
+          && infos[0].valid_data) {
+        ++received;
+      }
+    }
+  } else {
+    for (size_t i = 0; i < readers.size(); ++i) {
+      GroupCoherent::SampleSeq data;
+      DDS::SampleInfoSeq infos;
+      if (readers[i]->take(data, infos, DDS::LENGTH_UNLIMITED,
+                           DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE,
+                           DDS::ANY_INSTANCE_STATE) == DDS::RETCODE_OK) {
+        for (CORBA::ULong j = 0; j < infos.length(); ++j) {
+          if (infos[j].valid_data) {
+            ++received;
+          }
+        }
+      }
+    }
+  }
+  sub->end_access();
+  return received;
+}
+
+int
+run_test(int argc, ACE_TCHAR *argv[])
+{
+  DDS::DomainParticipantFactory_var dpf =
+    TheParticipantFactoryWithArgs(argc, argv);
+
+  if (parse_args(argc, argv) != 0) {
+    return 1;
+  }
+
+  DDS::DomainParticipant_var participant =
+    dpf->create_participant(111,
+                            PARTICIPANT_QOS_DEFAULT,
+                            DDS::DomainParticipantListener::_nil(),
+                            OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(participant.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_participant failed!\n")), 1);
+  }
+
+  GroupCoherent::SampleTypeSupport_var ts =
+    new GroupCoherent::SampleTypeSupportImpl;
+  if (ts->register_type(participant.in(), "") != DDS::RETCODE_OK) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: register_type failed!\n")), 1);
+  }
+
+  DDS::Topic_var topic =
+    participant->create_topic("GroupCoherent",
+                              CORBA::String_var(ts->get_type_name()),
+                              TOPIC_QOS_DEFAULT,
+                              DDS::TopicListener::_nil(),
+                              OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(topic.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_topic failed!\n")), 1);
+  }
+
+  DDS::PublisherQos pub_qos;
+  participant->get_default_publisher_qos(pub_qos);
+  pub_qos.presentation.access_scope = DDS::GROUP_PRESENTATION_QOS;
+  pub_qos.presentation.coherent_access = true;
+  pub_qos.presentation.ordered_access = ordered;
+
+  DDS::SubscriberQos sub_qos;
+  participant->get_default_subscriber_qos(sub_qos);
+  sub_qos.presentation = pub_qos.presentation;
+
+  DDS::Publisher_var pub =
+    participant->create_publisher(pub_qos, DDS::PublisherListener::_nil(),
+                                  OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::Subscriber_var sub =
+    participant->create_subscriber(sub_qos, DDS::SubscriberListener::_nil(),
+                                   OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(pub.in()) || CORBA::is_nil(sub.in())) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: create_publisher/subscriber failed!\n")), 1);
+  }
+
+  DDS::DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+  dw_qos.resource_limits.max_samples_per_instance = DDS::LENGTH_UNLIMITED;
+
+  DDS::DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  dr_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+  dr_qos.resource_limits.max_samples_per_instance = DDS::LENGTH_UNLIMITED;
+
+  std::vector<GroupCoherent::SampleDataWriter_var> writers;
+  std::vector<GroupCoherent::SampleDataReader_var> readers;
+  for (int i = 0; i < num_writers; ++i) {
+    DDS::DataReader_var dr =
+      sub->create_datareader(topic.in(), dr_qos,
+                             DDS::DataReaderListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    DDS::DataWriter_var dw =
+      pub->create_datawriter(topic.in(), dw_qos,
+                             DDS::DataWriterListener::_nil(),
+                             OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+    if (CORBA::is_nil(dr.in()) || CORBA::is_nil(dw.in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: create_datareader/writer failed!\n")), 1);
+    }
+    readers.push_back(GroupCoherent::SampleDataReader::_narrow(dr));
+    writers.push_back(GroupCoherent::SampleDataWriter::_narrow(dw));
+  }
+
+  for (size_t i = 0; i < writers.size(); ++i) {
+    if (!wait_for_match(writers[i].in())) {
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("ERROR: writer %d did not match\n"), i), 1);
+    }
+  }
+
+  DDS::StatusCondition_var condition = sub->get_statuscondition();
+  condition->set_enabled_statuses(DDS::DATA_ON_READERS_STATUS);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition);
+  const DDS::Duration_t timeout = {30, 0};
+
+  int status = 0;
+  double total_visible = 0, total_take = 0;
+  const ACE_hrtime_t test_start = ACE_OS::gethrtime();
+
+  for (int set = 0; set < num_sets && status == 0; ++set) {
+    pub->begin_coherent_changes();
+    for (int i = 0; i < num_samples; ++i) {
+      const int w = i % num_writers;
+      GroupCoherent::Sample sample;
+      sample.id = (i / num_writers) % num_instances;
+      sample.set = set;
+      sample.seq = i;
+      if (writers[w]->write(sample, DDS::HANDLE_NIL) != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: write failed\n")));
+        status = 1;
+        break;
+      }
+    }
+    pub->end_coherent_changes();
+    const ACE_hrtime_t end = ACE_OS::gethrtime();
+
+    int received = 0;
+    double visible = 0;
+    while (status == 0 && received < num_samples) {
+      DDS::ConditionSeq conditions;
+      if (ws->wait(conditions, timeout) != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("ERROR: set %d timed out with %d of %d samples\n"),
+                   set, received, num_samples));
+        status = 1;
+        break;
+      }
+      if (received == 0) {
+        visible = usec_since(end);
+      }
+      const ACE_hrtime_t take_start = ACE_OS::gethrtime();
+      received += take_set(sub, readers);
+      total_take += usec_since(take_start);
+    }
+    total_visible += visible;
+
+    ACE_DEBUG((LM_INFO, ACE_TEXT("set %d: %d samples visible after %.0f us\n"),
+               set, received, visible));
+  }
+
+  if (status == 0) {
+    const double elapsed = usec_since(test_start);
+    ACE_DEBUG((LM_INFO,
+               ACE_TEXT("%d sets of %d samples over %d writers%C: ")
+               ACE_TEXT("mean visible %.0f us, mean take %.0f us, ")
+               ACE_TEXT("%.0f samples/s\n"),
+               num_sets, num_samples, num_writers,
+               ordered ? " (ordered)" : "",
+               total_visible / num_sets, total_take / num_sets,
+               num_sets * static_cast<double>(num_samples) * 1e6 / elapsed));
+  }
+
+  ws->detach_condition(condition);
+  participant->delete_contained_entities();
+  dpf->delete_participant(participant.in());
+  return status;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 1;
+  try {
+    status = run_test(argc, argv);
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("Exception caught in main():");
+  }
+
+  TheServiceParticipant->shutdown();
+  return status;
+}
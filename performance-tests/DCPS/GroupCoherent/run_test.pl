@@ -0,0 +1,36 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $dcpsrepo_ior = "repo.ior";
+unlink $dcpsrepo_ior;
+
+my $opts = join(' ', @ARGV);
+
+my $DCPSREPO = PerlDDS::create_process("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
+                                       "-NOBITS -o $dcpsrepo_ior");
+$DCPSREPO->Spawn();
+if (PerlACE::waitforfile_timed($dcpsrepo_ior, 30) == -1) {
+    print STDERR "ERROR: waiting for Info Repo IOR file\n";
+    $DCPSREPO->Kill();
+    exit 1;
+}
+
+my $TEST = PerlDDS::create_process('GroupCoherent',
+                                   "-DCPSConfigFile tcp.ini -DCPSBit 0 $opts");
+my $result = $TEST->SpawnWaitKill(300);
+if ($result != 0) {
+    print STDERR "ERROR: GroupCoherent returned $result\n";
+}
+
+$DCPSREPO->TerminateWaitKill(5);
+unlink $dcpsrepo_ior;
+
+exit (($result == 0) ? 0 : 1);
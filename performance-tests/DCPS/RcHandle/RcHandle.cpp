@@ -0,0 +1,141 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <ace/Get_Opt.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_time.h>
+#include <ace/High_Res_Timer.h>
+#include <ace/Thread_Manager.h>
+
+#include <dds/DCPS/RcObject.h>
+#include <dds/DCPS/RcHandle_T.h>
+
+using OpenDDS::DCPS::RcHandle;
+using OpenDDS::DCPS::RcObject;
+using OpenDDS::DCPS::WeakRcHandle;
+using OpenDDS::DCPS::make_rch;
+
+namespace {
+
+long iterations = 10000000;
+int num_threads = 4;
+
+class Counted : public RcObject {
+public:
+  Counted() : value_(0) {}
+  long value_;
+};
+
+typedef RcHandle<Counted> Counted_rch;
+
+int
+parse_args(int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("n:t:"));
+
+  int c;
+  while ((c = get_opts()) != -1) {
+    switch (c) {
+    case 'n':
+      iterations = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case 't':
+      num_threads = ACE_OS::atoi(get_opts.opt_arg());
+      break;
+    case '?':
+    default:
+      ACE_ERROR_RETURN((LM_ERROR,
+                        ACE_TEXT("usage: %s -n <iterations> -t <threads>\n"),
+                        argv[0]),
+                       -1);
+    }
+  }
+
+  if (iterations <= 0 || num_threads <= 0) {
+    ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: arguments must be positive\n")), -1);
+  }
+  return 0;
+}
+
+double
+nsec_since(ACE_hrtime_t start)
+{
+  return static_cast<double>(ACE_OS::gethrtime() - start) * 1000.0
+    / ACE_High_Res_Timer::global_scale_factor();
+}
+
+void
+report(const char* what, double nsec, long ops)
+{
+  ACE_DEBUG((LM_INFO, ACE_TEXT("%-16C %8.2f ns/op\n"), what, nsec / ops));
+}
+
+long
+copy_loop(const Counted_rch& shared)
+{
+  long sum = 0;
+  for (long i = 0; i < iterations; ++i) {
+    const Counted_rch copy(shared);
+    sum += copy->value_;
+  }
+  return sum;
+}
+
+ACE_THR_FUNC_RETURN
+copy_thread(void* arg)
+{
+  copy_loop(*static_cast<Counted_rch*>(arg));
+  return 0;
+}
+
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args(argc, argv) != 0) {
+    return 1;
+  }
+
+  Counted_rch shared = make_rch<Counted>();
+  long sum = 0;
+
+  ACE_hrtime_t start = ACE_OS::gethrtime();
+  sum += copy_loop(shared);
+  report("copy", nsec_since(start), iterations);
+
+  start = ACE_OS::gethrtime();
+  if (ACE_Thread_Manager::instance()->spawn_n(num_threads, copy_thread,
+                                              &shared) == -1) {
+    ACE_ERROR_RETURN((LM_ERROR, ACE_TEXT("ERROR: spawn_n failed\n")), 1);
+  }
+  ACE_Thread_Manager::instance()->wait();
+  report("copy (threads)", nsec_since(start), iterations);
+
+  start = ACE_OS::gethrtime();
+  for (long i = 0; i < iterations; ++i) {
+    const Counted_rch created = make_rch<Counted>();
+    sum += created->value_;
+  }
+  report("create", nsec_since(start), iterations);
+
+  const WeakRcHandle<Counted> weak(shared);
+  start = ACE_OS::gethrtime();
+  for (long i = 0; i < iterations; ++i) {
+    const Counted_rch locked = weak.lock();
+    sum += locked->value_;
+  }
+  report("weak lock", nsec_since(start), iterations);
+
+  if (sum != 0 || shared->ref_count() != 1) {
+    ACE_ERROR_RETURN((LM_ERROR,
+                      ACE_TEXT("ERROR: unexpected reference count %d\n"),
+                      int(shared->ref_count())), 1);
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $opts = join(' ', @ARGV);
+
+my $TEST = PerlDDS::create_process('RcHandle', $opts);
+my $result = $TEST->SpawnWaitKill(300);
+if ($result != 0) {
+    print STDERR "ERROR: RcHandle returned $result\n";
+}
+
+exit (($result == 0) ? 0 : 1);
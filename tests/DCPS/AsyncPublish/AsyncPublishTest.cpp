@@ -0,0 +1,219 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/DataWriterImpl.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+const CORBA::Long samples_per_key = 50;
+const CORBA::Long keys = 2;
+
+string text_for(CORBA::Long iteration)
+{
+  return string(iteration % 13 * 40 + 1, static_cast<char>('a' + iteration % 26));
+}
+
+bool wait_for_match(const DataWriter_var& dw)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < 1) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_match: timed out" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+// Write iterations [first, first + count) of every key.
+bool write_samples(const DataWriter_var& dw, CORBA::Long first,
+                   CORBA::Long count)
+{
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Message sample;
+  sample.from = "async writer";
+  for (CORBA::Long i = first; i < first + count; ++i) {
+    for (CORBA::Long key = 0; key < keys; ++key) {
+      sample.key = key;
+      sample.iteration = i;
+      sample.text = text_for(i).c_str();
+      if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: write_samples: write failed" << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Take samples until every key got count of them, in order.
+bool take_samples(const DataReader_var& dr, CORBA::Long count)
+{
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  ReadCondition_var rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(rc);
+
+  bool passed = true;
+  CORBA::Long next[keys] = {0};
+  CORBA::Long received = 0;
+  while (received < keys * count) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: take_samples: got " << received << " of "
+           << keys * count << " samples" << endl;
+      passed = false;
+      break;
+    }
+    MessageSeq data;
+    SampleInfoSeq info;
+    while (mdr->take_w_condition(data, info, LENGTH_UNLIMITED, rc)
+           == RETCODE_OK) {
+      for (CORBA::ULong i = 0; i < data.length(); ++i) {
+        if (!info[i].valid_data) {
+          continue;
+        }
+        const Message& msg = data[i];
+        if (msg.key < 0 || msg.key >= keys || msg.iteration != next[msg.key]
+            || text_for(msg.iteration) != msg.text.in()) {
+          cerr << "ERROR: take_samples: unexpected key " << msg.key
+               << " iteration " << msg.iteration << endl;
+          passed = false;
+        } else {
+          ++next[msg.key];
+        }
+        ++received;
+      }
+      mdr->return_loan(data, info);
+    }
+  }
+
+  ws->detach_condition(rc);
+  dr->delete_readcondition(rc);
+  return passed;
+}
+
+bool run_async_test(const DomainParticipant_var& dp, const char* topic_name,
+                    const char* type_name, size_t bytes_per_second)
+{
+  Topic_var topic = dp->create_topic(topic_name, type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataWriterImpl* const dw_impl = dynamic_cast<DataWriterImpl*>(dw.in());
+  if (!dr || !dw_impl || !dw_impl->asynchronous_publish(true, bytes_per_second)
+      || !wait_for_match(dw)) {
+    cerr << "ERROR: run_async_test: " << topic_name << " setup failed" << endl;
+    return false;
+  }
+
+  bool passed = true;
+  if (!write_samples(dw, 0, samples_per_key)) {
+    passed = false;
+  }
+  // The samples were queued for a publication thread, the writer must
+  // still know they are unacknowledged.
+  if (dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: run_async_test: " << topic_name
+         << " wait_for_acknowledgments failed" << endl;
+    passed = false;
+  }
+
+  // Turning asynchronous publishing off doesn't lose samples that are
+  // still queued.
+  if (!write_samples(dw, samples_per_key, samples_per_key)) {
+    passed = false;
+  }
+  dw_impl->asynchronous_publish(false);
+  if (dw_impl->asynchronous_publish()) {
+    cerr << "ERROR: run_async_test: " << topic_name
+         << " asynchronous publishing still enabled" << endl;
+    passed = false;
+  }
+  if (dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: run_async_test: " << topic_name
+         << " wait_for_acknowledgments after disabling failed" << endl;
+    passed = false;
+  }
+
+  passed &= take_samples(dr, 2 * samples_per_key);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+
+  bool passed = true;
+  passed &= run_async_test(dp, "AsyncPublish", type_name, 0);
+  passed &= run_async_test(dp, "AsyncPublishRateLimited", type_name, 200000);
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in AsyncPublishTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
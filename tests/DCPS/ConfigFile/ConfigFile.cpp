@@ -43,6 +43,7 @@ ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     TEST_CHECK(OpenDDS::DCPS::DCPS_debug_level == 1);
     TEST_CHECK(TheServiceParticipant->n_chunks() == 10);
     TEST_CHECK(TheServiceParticipant->association_chunk_multiplier() == 5);
+    TEST_CHECK(TheServiceParticipant->publication_threads() == 2);
     TEST_CHECK(TheServiceParticipant->liveliness_factor() == 70);
     TEST_CHECK(TheServiceParticipant->bit_transport_port() == 1234);
     TEST_CHECK(TheServiceParticipant->bit_lookup_duration_msec() == 1000);
@@ -0,0 +1,398 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/LocalObject.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Task.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// Enough samples, some of them large, that the history is replayed in
+// more than one RTPS Message.
+const CORBA::Long history_size = 60;
+
+string text_for(CORBA::Long iteration)
+{
+  return string((iteration % 7) * 500 + 1, static_cast<char>('a' + iteration % 26));
+}
+
+class HistoryListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener>
+{
+public:
+  HistoryListener()
+    : notifications_(0)
+    , samples_(0)
+    , last_live_(-1)
+    , in_order_(true)
+  {}
+
+  virtual void on_requested_deadline_missed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedDeadlineMissedStatus & /*status*/) {}
+
+  virtual void on_requested_incompatible_qos(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedIncompatibleQosStatus & /*status*/) {}
+
+  virtual void on_liveliness_changed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::LivelinessChangedStatus & /*status*/) {}
+
+  virtual void on_subscription_matched(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SubscriptionMatchedStatus & /*status*/) {}
+
+  virtual void on_sample_rejected(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleRejectedStatus& /*status*/) {}
+
+  virtual void on_data_available(DDS::DataReader_ptr reader)
+  {
+    MessageDataReader_var mdr = MessageDataReader::_narrow(reader);
+    MessageSeq data;
+    SampleInfoSeq info;
+    const ReturnCode_t ret = mdr->read(data, info, LENGTH_UNLIMITED,
+      NOT_READ_SAMPLE_STATE, ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    ++notifications_;
+    if (ret != RETCODE_OK) {
+      return;
+    }
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      if (!info[i].valid_data) {
+        continue;
+      }
+      if (data[i].key != 1) {
+        last_live_ = std::max(last_live_, data[i].iteration);
+        continue;
+      }
+      if (data[i].iteration != samples_
+          || text_for(samples_) != data[i].text.in()) {
+        cerr << "ERROR: on_data_available: expected iteration " << samples_
+             << ", got " << data[i].iteration << endl;
+        in_order_ = false;
+      }
+      ++samples_;
+    }
+    mdr->return_loan(data, info);
+  }
+
+  virtual void on_sample_lost(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleLostStatus& /*status*/) {}
+
+  int notifications() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    return notifications_;
+  }
+
+  int samples() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    return samples_;
+  }
+
+  /// Highest iteration taken from the live writer
+  int last_live() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, -1);
+    return last_live_;
+  }
+
+  bool in_order() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, false);
+    return in_order_;
+  }
+
+private:
+  mutable ACE_Thread_Mutex lock_;
+  int notifications_;
+  int samples_;
+  int last_live_;
+  bool in_order_;
+};
+
+// Writes live samples of another instance until stopped
+class LiveWriterTask : public ACE_Task_Base {
+public:
+  explicit LiveWriterTask(const DataWriter_var& dw)
+    : dw_(MessageDataWriter::_narrow(dw))
+    , written_(0)
+    , stop_(false)
+    , failed_(false)
+  {}
+
+  int svc()
+  {
+    Message sample;
+    sample.from = "live writer";
+    sample.key = 2;
+    sample.text = "live";
+    while (!stopped()) {
+      sample.iteration = written();
+      if (dw_->write(sample, HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: LiveWriterTask: write failed" << endl;
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, -1);
+        failed_ = true;
+        return -1;
+      }
+      {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, -1);
+        ++written_;
+      }
+      ACE_OS::sleep(ACE_Time_Value(0, 2000));
+    }
+    return 0;
+  }
+
+  void stop()
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    stop_ = true;
+  }
+
+  int written() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    return written_;
+  }
+
+  bool failed() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return failed_;
+  }
+
+private:
+  bool stopped() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return stop_;
+  }
+
+  MessageDataWriter_var dw_;
+  mutable ACE_Thread_Mutex lock_;
+  int written_;
+  bool stop_;
+  bool failed_;
+};
+
+bool write_history(const DataWriter_var& dw)
+{
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Message sample;
+  sample.from = "historic writer";
+  sample.key = 1;
+  for (CORBA::Long i = 0; i < history_size; ++i) {
+    sample.iteration = i;
+    sample.text = text_for(i).c_str();
+    if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+      cerr << "ERROR: write_history: write failed" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Poll until the listener saw the whole history or max_wait_time passes
+bool wait_for_history(const HistoryListener& listener)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+  while (listener.samples() < history_size) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      cerr << "ERROR: wait_for_history: got " << listener.samples()
+           << " of " << history_size << " samples" << endl;
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return true;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("HistoricBatch", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  dw_qos.durability.kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  if (!dw || !write_history(dw)) {
+    cerr << "ERROR: run_test: writer setup failed" << endl;
+    return 1;
+  }
+
+  // The reader joins after the whole history was written, every sample
+  // it gets is historic.
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  dr_qos.durability.kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+  HistoryListener* const listener_impl = new HistoryListener;
+  DataReaderListener_var listener(listener_impl);
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, listener,
+                                             DATA_AVAILABLE_STATUS);
+  if (!dr) {
+    cerr << "ERROR: run_test: reader setup failed" << endl;
+    return 1;
+  }
+
+  bool passed = wait_for_history(*listener_impl);
+  if (!listener_impl->in_order()) {
+    cerr << "ERROR: run_test: history was not delivered in order" << endl;
+    passed = false;
+  }
+
+  // The history is stored as one batch, the listener is called once
+  // for all of it.
+  if (listener_impl->notifications() != 1) {
+    cerr << "ERROR: run_test: expected 1 on_data_available for the "
+         << "history, got " << listener_impl->notifications() << endl;
+    passed = false;
+  }
+
+  // Samples written after the history are still notified one by one
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Message sample;
+  sample.from = "historic writer";
+  sample.key = 1;
+  sample.iteration = history_size;
+  sample.text = text_for(history_size).c_str();
+  if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK
+      || dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: run_test: live write failed" << endl;
+    passed = false;
+  } else {
+    const ACE_Time_Value deadline =
+      ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+    while (listener_impl->samples() <= history_size
+           && ACE_OS::gettimeofday() < deadline) {
+      ACE_OS::sleep(ACE_Time_Value(0, 100000));
+    }
+    if (listener_impl->samples() != history_size + 1
+        || listener_impl->notifications() != 2) {
+      cerr << "ERROR: run_test: live sample not notified, got "
+           << listener_impl->samples() << " samples in "
+           << listener_impl->notifications() << " notifications" << endl;
+      passed = false;
+    }
+  }
+
+  // Another reader joins while a second writer keeps writing live
+  // samples, those arrive during the replay of the history and must be
+  // notified as usual.
+  dw_qos.history.kind = KEEP_LAST_HISTORY_QOS;
+  dw_qos.history.depth = 1;
+  DataWriter_var live_dw = pub->create_datawriter(topic, dw_qos, 0,
+                                                  DEFAULT_STATUS_MASK);
+  HistoryListener* const mixed_impl = new HistoryListener;
+  DataReaderListener_var mixed_listener(mixed_impl);
+  DataReader_var mixed_dr;
+  if (!live_dw) {
+    cerr << "ERROR: run_test: live writer setup failed" << endl;
+    passed = false;
+  } else {
+    LiveWriterTask live_writer(live_dw);
+    live_writer.activate(THR_NEW_LWP | THR_JOINABLE);
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+    mixed_dr = sub->create_datareader(topic, dr_qos, mixed_listener,
+                                      DATA_AVAILABLE_STATUS);
+    if (!mixed_dr) {
+      cerr << "ERROR: run_test: second reader setup failed" << endl;
+      passed = false;
+    } else if (!wait_for_history(*mixed_impl)) {
+      passed = false;
+    }
+    live_writer.stop();
+    live_writer.wait();
+    if (live_writer.failed()
+        || live_dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: run_test: live writer failed" << endl;
+      passed = false;
+    }
+
+    const int last = live_writer.written() - 1;
+    const ACE_Time_Value deadline =
+      ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+    while (mixed_impl->last_live() < last
+           && ACE_OS::gettimeofday() < deadline) {
+      ACE_OS::sleep(ACE_Time_Value(0, 100000));
+    }
+    if (mixed_impl->last_live() != last) {
+      cerr << "ERROR: run_test: live sample " << last << " not notified, "
+           << "last one taken was " << mixed_impl->last_live() << endl;
+      passed = false;
+    }
+    if (!mixed_impl->in_order()) {
+      cerr << "ERROR: run_test: history was not delivered in order to the "
+           << "second reader" << endl;
+      passed = false;
+    }
+  }
+
+  dr->set_listener(0, NO_STATUS_MASK);
+  if (mixed_dr) {
+    mixed_dr->set_listener(0, NO_STATUS_MASK);
+  }
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in HistoricBatchTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
@@ -0,0 +1,336 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/DataReaderImpl.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// Each iteration gets a text of a different length
+string text_for(CORBA::Long iteration)
+{
+  return string(3 * iteration + 1, static_cast<char>('a' + iteration));
+}
+
+bool check_sample(const char* test, const Message& msg, const SampleInfo& info,
+                  CORBA::Long key, CORBA::Long iteration)
+{
+  if (!info.valid_data) {
+    cerr << "ERROR: " << test << ": sample " << iteration
+         << " has no valid data" << endl;
+    return false;
+  }
+  if (msg.key != key || msg.iteration != iteration
+      || string(msg.from.in()) != "lazy writer"
+      || text_for(iteration) != msg.text.in()) {
+    cerr << "ERROR: " << test << ": expected key " << key << " iteration "
+         << iteration << ", got key " << msg.key << " iteration "
+         << msg.iteration << " from \"" << msg.from.in() << "\" text \""
+         << msg.text.in() << '"' << endl;
+    return false;
+  }
+  return true;
+}
+
+DataReader_var create_lazy_reader(const Subscriber_var& sub,
+                                  TopicDescription_ptr topic,
+                                  const DataReaderQos& qos)
+{
+  // The subscriber doesn't enable its readers, lazy_deserialization()
+  // must be set before enable().
+  DataReader_var dr = sub->create_datareader(topic, qos, 0, DEFAULT_STATUS_MASK);
+  DataReaderImpl* const impl = dynamic_cast<DataReaderImpl*>(dr.in());
+  if (!impl) {
+    cerr << "ERROR: create_lazy_reader: create_datareader failed" << endl;
+    return DataReader_var();
+  }
+  impl->lazy_deserialization() = true;
+  if (dr->enable() != RETCODE_OK) {
+    cerr << "ERROR: create_lazy_reader: enable failed" << endl;
+    return DataReader_var();
+  }
+  return dr;
+}
+
+bool wait_for_match(const DataWriter_var& dw, CORBA::Long readers)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < readers) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_match: timed out" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+DataWriter_var create_writer(const Publisher_var& pub, const Topic_var& topic)
+{
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  return pub->create_datawriter(topic, dw_qos, 0, DEFAULT_STATUS_MASK);
+}
+
+DataReaderQos reliable_reader_qos(const Subscriber_var& sub)
+{
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  return dr_qos;
+}
+
+// Write iterations [0, count) of key and wait until they are delivered.
+bool write_samples(const DataWriter_var& dw, CORBA::Long key, CORBA::Long count)
+{
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Message sample;
+  sample.from = "lazy writer";
+  sample.key = key;
+  for (CORBA::Long i = 0; i < count; ++i) {
+    sample.iteration = i;
+    sample.text = text_for(i).c_str();
+    if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+      cerr << "ERROR: write_samples: write failed" << endl;
+      return false;
+    }
+  }
+  if (dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: write_samples: wait_for_acknowledgments failed" << endl;
+    return false;
+  }
+  return true;
+}
+
+bool run_read_take_test(const DomainParticipant_var& dp,
+  const Publisher_var& pub, const Subscriber_var& sub, const char* type_name)
+{
+  Topic_var topic = dp->create_topic("LazyReadTake", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos = reliable_reader_qos(sub);
+  DataReader_var dr = create_lazy_reader(sub, topic, dr_qos);
+  dr_qos.history.kind = KEEP_LAST_HISTORY_QOS;
+  dr_qos.history.depth = 1;
+  DataReader_var dr_last = create_lazy_reader(sub, topic, dr_qos);
+  DataWriter_var dw = create_writer(pub, topic);
+  if (!dr || !dr_last || !dw || !wait_for_match(dw, 2)
+      || !write_samples(dw, 1, 3)) {
+    cerr << "ERROR: run_read_take_test: setup failed" << endl;
+    return false;
+  }
+
+  bool passed = true;
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  MessageSeq data;
+  SampleInfoSeq info;
+  if (mdr->read(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK
+      || data.length() != 3) {
+    cerr << "ERROR: run_read_take_test: read should return 3 samples" << endl;
+    return false;
+  }
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    passed &= check_sample("read", data[i], info[i], 1, i);
+  }
+  mdr->return_loan(data, info);
+
+  // The samples already read are demarshaled, take them again
+  if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK
+      || data.length() != 3) {
+    cerr << "ERROR: run_read_take_test: take should return 3 samples" << endl;
+    return false;
+  }
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    passed &= check_sample("take", data[i], info[i], 1, i);
+  }
+  mdr->return_loan(data, info);
+
+  if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_NO_DATA) {
+    cerr << "ERROR: run_read_take_test: samples left after take" << endl;
+    passed = false;
+  }
+
+  // Only the last sample is kept, the ones it replaced were never read
+  MessageDataReader_var mdr_last = MessageDataReader::_narrow(dr_last);
+  Message sample;
+  SampleInfo sample_info;
+  if (mdr_last->take_next_sample(sample, sample_info) != RETCODE_OK) {
+    cerr << "ERROR: run_read_take_test: take_next_sample failed" << endl;
+    passed = false;
+  } else {
+    passed &= check_sample("take_next_sample", sample, sample_info, 1, 2);
+  }
+  if (mdr_last->take_next_sample(sample, sample_info) != RETCODE_NO_DATA) {
+    cerr << "ERROR: run_read_take_test: KEEP_LAST reader kept more than "
+         << "its depth" << endl;
+    passed = false;
+  }
+
+  return passed;
+}
+
+bool run_content_filter_test(const DomainParticipant_var& dp,
+  const Publisher_var& pub, const Subscriber_var& sub, const char* type_name)
+{
+  Topic_var topic = dp->create_topic("LazyContentFilter", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+  ContentFilteredTopic_var cft = dp->create_contentfilteredtopic(
+    "LazyContentFilter-cft", topic, "iteration >= 2 AND from = 'lazy writer'",
+    StringSeq());
+  DataReader_var dr = create_lazy_reader(sub, cft, reliable_reader_qos(sub));
+  DataWriter_var dw = create_writer(pub, topic);
+  if (!cft || !dr || !dw || !wait_for_match(dw, 1)
+      || !write_samples(dw, 2, 5)) {
+    cerr << "ERROR: run_content_filter_test: setup failed" << endl;
+    return false;
+  }
+
+  bool passed = true;
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  MessageSeq data;
+  SampleInfoSeq info;
+  if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK
+      || data.length() != 3) {
+    cerr << "ERROR: run_content_filter_test: take should return the 3 "
+         << "samples passing the filter, got " << data.length() << endl;
+    return false;
+  }
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    passed &= check_sample("content filter", data[i], info[i], 2, i + 2);
+  }
+  mdr->return_loan(data, info);
+  return passed;
+}
+
+bool run_query_condition_test(const DomainParticipant_var& dp,
+  const Publisher_var& pub, const Subscriber_var& sub, const char* type_name)
+{
+  Topic_var topic = dp->create_topic("LazyQueryCondition", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+  DataReader_var dr = create_lazy_reader(sub, topic, reliable_reader_qos(sub));
+  DataWriter_var dw = create_writer(pub, topic);
+  if (!dr || !dw || !wait_for_match(dw, 1) || !write_samples(dw, 3, 5)) {
+    cerr << "ERROR: run_query_condition_test: setup failed" << endl;
+    return false;
+  }
+
+  StringSeq params(1);
+  params.length(1);
+  params[0] = "2";
+  ReadCondition_var dr_qc = dr->create_querycondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE, "iteration > %0", params);
+  if (!dr_qc) {
+    cerr << "ERROR: run_query_condition_test: failed to create "
+         << "QueryCondition" << endl;
+    return false;
+  }
+
+  bool passed = true;
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  MessageSeq data;
+  SampleInfoSeq info;
+  if (mdr->read_w_condition(data, info, LENGTH_UNLIMITED, dr_qc) != RETCODE_OK
+      || data.length() != 2) {
+    cerr << "ERROR: run_query_condition_test: read_w_condition should "
+         << "return 2 samples, got " << data.length() << endl;
+    passed = false;
+  } else {
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      passed &= check_sample("read_w_condition", data[i], info[i], 3, i + 3);
+    }
+    mdr->return_loan(data, info);
+  }
+
+  // The samples that didn't match are still intact
+  if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK
+      || data.length() != 5) {
+    cerr << "ERROR: run_query_condition_test: take should return 5 "
+         << "samples, got " << data.length() << endl;
+    passed = false;
+  } else {
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      passed &= check_sample("take after query", data[i], info[i], 3, i);
+    }
+    mdr->return_loan(data, info);
+  }
+
+  dr->delete_readcondition(dr_qc);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+
+  SubscriberQos sub_qos;
+  dp->get_default_subscriber_qos(sub_qos);
+  sub_qos.entity_factory.autoenable_created_entities = false;
+  Subscriber_var sub = dp->create_subscriber(sub_qos, 0, DEFAULT_STATUS_MASK);
+
+  bool passed = true;
+  passed &= run_read_take_test(dp, pub, sub, type_name);
+  passed &= run_content_filter_test(dp, pub, sub, type_name);
+  passed &= run_query_condition_test(dp, pub, sub, type_name);
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in LazyDeserializationTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
@@ -0,0 +1,27 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+# Samples must reach the reader unfiltered to test its content filter.
+my $opts = '-DCPSPublisherContentFilter 0';
+
+if (scalar @ARGV && $ARGV[0] =~ /^-d/i) {
+  $opts .= " -DCPSTransportDebugLevel 6 -DCPSDebugLevel 10";
+}
+
+my $TEST = PerlDDS::create_process ('LazyDeserializationTest',
+                                    "-DCPSConfigFile ../MessengerCommon/rtps_disc.ini $opts");
+print STDERR $TEST->CommandLine () . "\n";
+my $result = $TEST->SpawnWaitKill(60);
+if ($result != 0) {
+  print STDERR "ERROR: test returned $result\n";
+}
+
+exit (($result == 0) ? 0 : 1);
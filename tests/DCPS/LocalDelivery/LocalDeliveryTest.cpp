@@ -0,0 +1,335 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/LocalObject.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+# include "dds/DCPS/transport/shmem/Shmem.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+const CORBA::Long samples = 20;
+const CORBA::Long rounds = 50;
+
+string text_for(CORBA::Long iteration)
+{
+  return string(iteration % 11 * 10 + 1, static_cast<char>('a' + iteration % 26));
+}
+
+bool wait_for_match(const DataWriter_var& dw)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < 1) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_match: timed out" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+DataWriter_var create_writer(const Publisher_var& pub, const Topic_var& topic)
+{
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  return pub->create_datawriter(topic, dw_qos, 0, DEFAULT_STATUS_MASK);
+}
+
+DataReader_var create_reader(const Subscriber_var& sub, const Topic_var& topic,
+                             DataReaderListener_ptr listener)
+{
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  return sub->create_datareader(topic, dr_qos, listener,
+                                listener ? DATA_AVAILABLE_STATUS
+                                         : DEFAULT_STATUS_MASK);
+}
+
+// Answers every sample it takes by writing it back on reply_, the
+// iteration incremented by increment, until it has seen last.
+class ReplyListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener>
+{
+public:
+  ReplyListener(CORBA::Long increment, CORBA::Long last)
+    : increment_(increment)
+    , last_(last)
+    , next_(0)
+    , in_order_(true)
+  {}
+
+  void reply(const DataWriter_var& dw)
+  {
+    reply_ = MessageDataWriter::_narrow(dw);
+  }
+
+  virtual void on_requested_deadline_missed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedDeadlineMissedStatus & /*status*/) {}
+
+  virtual void on_requested_incompatible_qos(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedIncompatibleQosStatus & /*status*/) {}
+
+  virtual void on_liveliness_changed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::LivelinessChangedStatus & /*status*/) {}
+
+  virtual void on_subscription_matched(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SubscriptionMatchedStatus & /*status*/) {}
+
+  virtual void on_sample_rejected(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleRejectedStatus& /*status*/) {}
+
+  virtual void on_data_available(DDS::DataReader_ptr reader)
+  {
+    MessageDataReader_var mdr = MessageDataReader::_narrow(reader);
+    Message msg;
+    SampleInfo info;
+    while (mdr->take_next_sample(msg, info) == RETCODE_OK) {
+      if (!info.valid_data) {
+        continue;
+      }
+      {
+        ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+        if (msg.iteration != next_) {
+          cerr << "ERROR: ReplyListener: expected iteration " << next_
+               << ", got " << msg.iteration << endl;
+          in_order_ = false;
+        }
+        next_ = msg.iteration + 1;
+      }
+      if (msg.iteration >= last_) {
+        continue;
+      }
+      // Written from the listener of a sample sent on the same kind of
+      // link: this is where delivery under the sender's lock deadlocks.
+      msg.iteration += increment_;
+      msg.text = text_for(msg.iteration).c_str();
+      if (reply_->write(msg, HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: ReplyListener: write failed" << endl;
+      }
+    }
+  }
+
+  virtual void on_sample_lost(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleLostStatus& /*status*/) {}
+
+  CORBA::Long next() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    return next_;
+  }
+
+  bool in_order() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, false);
+    return in_order_;
+  }
+
+private:
+  const CORBA::Long increment_;
+  const CORBA::Long last_;
+  MessageDataWriter_var reply_;
+  mutable ACE_Thread_Mutex lock_;
+  CORBA::Long next_;
+  bool in_order_;
+};
+
+bool run_delivery_test(const DomainParticipant_var& dp,
+  const Publisher_var& pub, const Subscriber_var& sub, const char* type_name)
+{
+  Topic_var topic = dp->create_topic("LocalDelivery", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+  DataReader_var dr = create_reader(sub, topic, 0);
+  DataWriter_var dw = create_writer(pub, topic);
+  if (!dr || !dw || !wait_for_match(dw)) {
+    cerr << "ERROR: run_delivery_test: setup failed" << endl;
+    return false;
+  }
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Message sample;
+  sample.from = "local writer";
+  sample.key = 1;
+  for (CORBA::Long i = 0; i < samples; ++i) {
+    sample.iteration = i;
+    sample.text = text_for(i).c_str();
+    if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+      cerr << "ERROR: run_delivery_test: write failed" << endl;
+      return false;
+    }
+  }
+
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  ReadCondition_var rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(rc);
+
+  bool passed = true;
+  CORBA::Long next = 0;
+  while (next < samples) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: run_delivery_test: got " << next << " of " << samples
+           << " samples" << endl;
+      passed = false;
+      break;
+    }
+    Message msg;
+    SampleInfo info;
+    while (mdr->take_next_sample(msg, info) == RETCODE_OK) {
+      if (!info.valid_data) {
+        continue;
+      }
+      if (msg.iteration != next || text_for(next) != msg.text.in()
+          || string(msg.from.in()) != "local writer") {
+        cerr << "ERROR: run_delivery_test: expected iteration " << next
+             << ", got " << msg.iteration << endl;
+        passed = false;
+      }
+      next = msg.iteration + 1;
+    }
+  }
+
+  ws->detach_condition(rc);
+  dr->delete_readcondition(rc);
+  return passed;
+}
+
+bool run_write_back_test(const DomainParticipant_var& dp,
+  const Publisher_var& pub, const Subscriber_var& sub, const char* type_name)
+{
+  Topic_var ping_topic = dp->create_topic("LocalPing", type_name,
+                                          TOPIC_QOS_DEFAULT, 0,
+                                          DEFAULT_STATUS_MASK);
+  Topic_var pong_topic = dp->create_topic("LocalPong", type_name,
+                                          TOPIC_QOS_DEFAULT, 0,
+                                          DEFAULT_STATUS_MASK);
+
+  // A ping is answered by a pong of the same iteration, which is
+  // answered by the next ping.
+  ReplyListener* const ping_impl = new ReplyListener(0, rounds + 1);
+  DataReaderListener_var ping_listener(ping_impl);
+  ReplyListener* const pong_impl = new ReplyListener(1, rounds);
+  DataReaderListener_var pong_listener(pong_impl);
+
+  DataWriter_var ping_dw = create_writer(pub, ping_topic);
+  DataWriter_var pong_dw = create_writer(pub, pong_topic);
+  ping_impl->reply(pong_dw);
+  pong_impl->reply(ping_dw);
+  DataReader_var ping_dr = create_reader(sub, ping_topic, ping_listener);
+  DataReader_var pong_dr = create_reader(sub, pong_topic, pong_listener);
+  if (!ping_dr || !pong_dr || !ping_dw || !pong_dw
+      || !wait_for_match(ping_dw) || !wait_for_match(pong_dw)) {
+    cerr << "ERROR: run_write_back_test: setup failed" << endl;
+    return false;
+  }
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(ping_dw);
+  Message sample;
+  sample.from = "local writer";
+  sample.key = 1;
+  sample.iteration = 0;
+  sample.text = text_for(0).c_str();
+  if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+    cerr << "ERROR: run_write_back_test: write failed" << endl;
+    return false;
+  }
+
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+  while (pong_impl->next() <= rounds && ACE_OS::gettimeofday() < deadline) {
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+
+  bool passed = true;
+  if (ping_impl->next() != rounds + 1 || pong_impl->next() != rounds + 1) {
+    cerr << "ERROR: run_write_back_test: exchange stopped at ping "
+         << ping_impl->next() << " pong " << pong_impl->next() << endl;
+    passed = false;
+  }
+  if (!ping_impl->in_order() || !pong_impl->in_order()) {
+    cerr << "ERROR: run_write_back_test: samples out of order" << endl;
+    passed = false;
+  }
+
+  ping_dr->set_listener(0, NO_STATUS_MASK);
+  pong_dr->set_listener(0, NO_STATUS_MASK);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+
+  bool passed = true;
+  passed &= run_delivery_test(dp, pub, sub, type_name);
+  passed &= run_write_back_test(dp, pub, sub, type_name);
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in LocalDeliveryTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
@@ -0,0 +1,59 @@
+
+// -*- C++ -*-
+// Definition for Win32 Export directives.
+// This file is generated automatically by generate_export_file.pl MessengerCommon
+// ------------------------------
+#ifndef MESSENGERCOMMON_EXPORT_H
+#define MESSENGERCOMMON_EXPORT_H
+
+#include "ace/config-all.h"
+
+#if defined (ACE_AS_STATIC_LIBS)
+# if !defined (MESSENGERCOMMON_HAS_DLL)
+#   define MESSENGERCOMMON_HAS_DLL 0
+# endif /* ! MESSENGERCOMMON_HAS_DLL */
+#else
+#if !defined (MESSENGERCOMMON_HAS_DLL)
+#  define MESSENGERCOMMON_HAS_DLL 1
+#endif /* ! MESSENGERCOMMON_HAS_DLL */
+#endif /* ACE_AS_STATIC_LIBS */
+
+#if defined (MESSENGERCOMMON_HAS_DLL) && (MESSENGERCOMMON_HAS_DLL == 1)
+#  if defined (MESSENGERCOMMON_BUILD_DLL)
+#    define MessengerCommon_Export ACE_Proper_Export_Flag
+#    define MESSENGERCOMMON_SINGLETON_DECLARATION(T) ACE_EXPORT_SINGLETON_DECLARATION (T)
+#    define MESSENGERCOMMON_SINGLETON_DECLARE(SINGLETON_TYPE, CLASS, LOCK) ACE_EXPORT_SINGLETON_DECLARE(SINGLETON_TYPE, CLASS, LOCK)
+#  else /* MESSENGERCOMMON_BUILD_DLL */
+#    define MessengerCommon_Export ACE_Proper_Import_Flag
+#    define MESSENGERCOMMON_SINGLETON_DECLARATION(T) ACE_IMPORT_SINGLETON_DECLARATION (T)
+#    define MESSENGERCOMMON_SINGLETON_DECLARE(SINGLETON_TYPE, CLASS, LOCK) ACE_IMPORT_SINGLETON_DECLARE(SINGLETON_TYPE, CLASS, LOCK)
+#  endif /* MESSENGERCOMMON_BUILD_DLL */
+#else /* MESSENGERCOMMON_HAS_DLL == 1 */
+#  define MessengerCommon_Export
+#  define MESSENGERCOMMON_SINGLETON_DECLARATION(T)
+#  define MESSENGERCOMMON_SINGLETON_DECLARE(SINGLETON_TYPE, CLASS, LOCK)
+#endif /* MESSENGERCOMMON_HAS_DLL == 1 */
+
+// Set MESSENGERCOMMON_NTRACE = 0 to turn on library specific tracing even if
+// tracing is turned off for ACE.
+#if !defined (MESSENGERCOMMON_NTRACE)
+#  if (ACE_NTRACE == 1)
+#    define MESSENGERCOMMON_NTRACE 1
+#  else /* (ACE_NTRACE == 1) */
+#    define MESSENGERCOMMON_NTRACE 0
+#  endif /* (ACE_NTRACE == 1) */
+#endif /* !MESSENGERCOMMON_NTRACE */
+
+#if (MESSENGERCOMMON_NTRACE == 1)
+#  define MESSENGERCOMMON_TRACE(X)
+#else /* (MESSENGERCOMMON_NTRACE == 1) */
+#  if !defined (ACE_HAS_TRACE)
+#    define ACE_HAS_TRACE
+#  endif /* ACE_HAS_TRACE */
+#  define MESSENGERCOMMON_TRACE(X) ACE_TRACE_IMPL(X)
+#  include "ace/Trace.h"
+#endif /* (MESSENGERCOMMON_NTRACE == 1) */
+
+#endif /* MESSENGERCOMMON_EXPORT_H */
+
+// End of auto generated file.
@@ -2,6 +2,7 @@
 #include <ace/OS_NS_string.h>
 #include <tao/SystemException.h>
 #include <dds/DCPS/FilterEvaluator.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
 
 #include "MetaStructTestTypeSupportImpl.h"
 
@@ -69,6 +70,47 @@ void fill_2d(short (&arr)[N][M])
   }
 }
 
+int check_field_ids(const Source& src, const MetaStruct& meta)
+{
+  int ret = 0;
+  const char* const fields[] = {"rhs_a.s", "rhs_a.l", "rhs_e"};
+  for (size_t i = 0; i < sizeof fields / sizeof fields[0]; ++i) {
+    const int id = meta.getFieldId(fields[i]);
+    if (id < 0) {
+      std::cout << "ERROR: no field id for " << fields[i] << std::endl;
+      ++ret;
+      continue;
+    }
+    if (!(meta.getValueById(&src, id) == meta.getValue(&src, fields[i]))) {
+      std::cout << "ERROR: getValueById differs for " << fields[i] << std::endl;
+      ++ret;
+    }
+    for (int align = 0; align < 2; ++align) {
+      size_t size = 0, padding = 0;
+      gen_find_size(src, size, padding);
+      ACE_Message_Block mb(size + padding);
+      const Serializer::Alignment a =
+        align ? Serializer::ALIGN_CDR : Serializer::ALIGN_NONE;
+      Serializer out(&mb, false, a);
+      if (!(out << src)) {
+        std::cout << "ERROR: serializing Source failed" << std::endl;
+        return ret + 1;
+      }
+      Message_Block_Ptr dup1(mb.duplicate()), dup2(mb.duplicate());
+      Serializer byName(dup1.get(), false, a), byId(dup2.get(), false, a);
+      if (!(meta.getValueById(byId, id) == meta.getValue(byName, fields[i]))) {
+        std::cout << "ERROR: serialized getValueById differs for " << fields[i]
+                  << (align ? " (aligned)" : "") << std::endl;
+        ++ret;
+      }
+    }
+  }
+  if (meta.getFieldId("rhs_ss") != -1) {
+    std::cout << "ERROR: sequence field has a field id" << std::endl;
+    ++ret;
+  }
+  return ret;
+}
 
 int run_test(int, ACE_TCHAR*[])
 {
@@ -110,7 +152,8 @@ int run_test(int, ACE_TCHAR*[])
     + check(tgt.lhs_ss[1].l, src.rhs_ss[1].l, "lhs_ss[1].l")
     + check(tgt.lhs_e, src.rhs_e, "lhs_e")
     + check(tgt.lhs_u._d(), src.rhs_u._d(), "lhs_u._d()")
-    + check(tgt.lhs_u.u_f(), src.rhs_u.u_f(), "lhs_u.u_f()");
+    + check(tgt.lhs_u.u_f(), src.rhs_u.u_f(), "lhs_u.u_f()")
+    + check_field_ids(src, sourceMeta);
 }
 
 int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
@@ -0,0 +1,338 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/LocalObject.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Task.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// Samples from the owner a reader must get after an ownership change
+// before the phase is checked.
+const size_t phase_samples = 20;
+
+// How long the writers keep writing once the owner changed, every sample
+// of the other writer the readers get meanwhile is an error.
+const ACE_Time_Value phase_hold(0, 500000);
+
+const size_t readers = 2;
+
+class OwnerListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener>
+{
+public:
+  virtual void on_requested_deadline_missed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedDeadlineMissedStatus & /*status*/) {}
+
+  virtual void on_requested_incompatible_qos(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedIncompatibleQosStatus & /*status*/) {}
+
+  virtual void on_liveliness_changed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::LivelinessChangedStatus & /*status*/) {}
+
+  virtual void on_subscription_matched(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SubscriptionMatchedStatus & /*status*/) {}
+
+  virtual void on_sample_rejected(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleRejectedStatus& /*status*/) {}
+
+  virtual void on_data_available(DDS::DataReader_ptr reader)
+  {
+    MessageDataReader_var mdr = MessageDataReader::_narrow(reader);
+    MessageSeq data;
+    SampleInfoSeq info;
+    if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                  ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK) {
+      return;
+    }
+
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      if (info[i].valid_data) {
+        from_.push_back(data[i].from.in());
+      }
+    }
+    mdr->return_loan(data, info);
+  }
+
+  virtual void on_sample_lost(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleLostStatus& /*status*/) {}
+
+  /// Writers of the samples taken so far, in order
+  vector<string> from() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, vector<string>());
+    return from_;
+  }
+
+private:
+  mutable ACE_Thread_Mutex lock_;
+  vector<string> from_;
+};
+
+// Writes the same instance until stopped
+class WriterTask : public ACE_Task_Base {
+public:
+  WriterTask(const DataWriter_var& dw, const char* name)
+    : dw_(MessageDataWriter::_narrow(dw))
+    , name_(name)
+    , stop_(false)
+    , failed_(false)
+  {}
+
+  int svc()
+  {
+    Message sample;
+    sample.from = name_;
+    sample.key = 1;
+    sample.iteration = 0;
+    sample.text = "ownership";
+    while (!stopped()) {
+      if (dw_->write(sample, HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: WriterTask: " << name_ << " write failed" << endl;
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, -1);
+        failed_ = true;
+        return -1;
+      }
+      ++sample.iteration;
+      ACE_OS::sleep(ACE_Time_Value(0, 5000));
+    }
+    return 0;
+  }
+
+  void stop()
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    stop_ = true;
+  }
+
+  bool failed() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return failed_;
+  }
+
+private:
+  bool stopped() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return stop_;
+  }
+
+  MessageDataWriter_var dw_;
+  const char* const name_;
+  mutable ACE_Thread_Mutex lock_;
+  bool stop_;
+  bool failed_;
+};
+
+bool set_strength(const DataWriter_var& dw, CORBA::Long strength)
+{
+  DataWriterQos qos;
+  dw->get_qos(qos);
+  qos.ownership_strength.value = strength;
+  if (dw->set_qos(qos) != RETCODE_OK) {
+    cerr << "ERROR: set_strength: set_qos failed" << endl;
+    return false;
+  }
+  return true;
+}
+
+// Poll until the listener took phase_samples samples of owner since
+// begin, first is the index of the first of them.
+bool wait_for_owner(const OwnerListener& listener, size_t begin,
+                    const string& owner, size_t& first)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+  while (true) {
+    const vector<string> from = listener.from();
+    size_t count = 0;
+    for (size_t i = begin; i < from.size(); ++i) {
+      if (from[i] == owner && count++ == 0) {
+        first = i;
+      }
+    }
+    if (count >= phase_samples) {
+      return true;
+    }
+    if (ACE_OS::gettimeofday() > deadline) {
+      cerr << "ERROR: wait_for_owner: got " << count << " of "
+           << phase_samples << " samples from " << owner << endl;
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+}
+
+// Once a sample from the owner was taken, samples from any other writer
+// must be filtered.
+bool only_owner(const OwnerListener& listener, size_t first,
+                const string& owner)
+{
+  const vector<string> from = listener.from();
+  for (size_t i = first; i < from.size(); ++i) {
+    if (from[i] != owner) {
+      cerr << "ERROR: only_owner: took sample " << i << " from " << from[i]
+           << " after " << owner << " became the owner at sample "
+           << first << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("OwnershipSwitch", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  // Several readers of the instance, the OwnershipManager updates the
+  // ownership slots of all of them while they check theirs.
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  dr_qos.ownership.kind = EXCLUSIVE_OWNERSHIP_QOS;
+  vector<OwnerListener*> listeners;
+  vector<DataReaderListener_var> listener_vars;
+  vector<DataReader_var> drs;
+  for (size_t i = 0; i < readers; ++i) {
+    listeners.push_back(new OwnerListener);
+    listener_vars.push_back(DataReaderListener_var(listeners.back()));
+    drs.push_back(sub->create_datareader(topic, dr_qos, listener_vars.back(),
+                                         DATA_AVAILABLE_STATUS));
+    if (!drs.back()) {
+      cerr << "ERROR: run_test: reader setup failed" << endl;
+      return 1;
+    }
+  }
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  dw_qos.ownership.kind = EXCLUSIVE_OWNERSHIP_QOS;
+  dw_qos.ownership_strength.value = 10;
+  DataWriter_var dw1 = pub->create_datawriter(topic, dw_qos, 0,
+                                              DEFAULT_STATUS_MASK);
+  dw_qos.ownership_strength.value = 5;
+  DataWriter_var dw2 = pub->create_datawriter(topic, dw_qos, 0,
+                                              DEFAULT_STATUS_MASK);
+  if (!dw1 || !dw2) {
+    cerr << "ERROR: run_test: writer setup failed" << endl;
+    return 1;
+  }
+
+  WriterTask writer1(dw1, "writer1");
+  WriterTask writer2(dw2, "writer2");
+  writer1.activate(THR_NEW_LWP | THR_JOINABLE);
+  writer2.activate(THR_NEW_LWP | THR_JOINABLE);
+
+  // Each phase changes one strength while both writers keep writing: the
+  // second and third phases move the ownership by raising the strength
+  // of the other writer, the last one by lowering that of the owner.
+  struct Phase {
+    DataWriter_var* dw;
+    CORBA::Long strength;
+    const char* owner;
+  } const phases[] = {
+    {0, 0, "writer1"},
+    {&dw2, 20, "writer2"},
+    {&dw1, 30, "writer1"},
+    {&dw1, 1, "writer2"}
+  };
+
+  bool passed = true;
+  for (size_t p = 0; passed && p < sizeof(phases) / sizeof(phases[0]); ++p) {
+    vector<size_t> begin;
+    for (size_t i = 0; i < readers; ++i) {
+      begin.push_back(listeners[i]->from().size());
+    }
+    if (phases[p].dw && !set_strength(*phases[p].dw, phases[p].strength)) {
+      passed = false;
+      break;
+    }
+
+    vector<size_t> first(readers, 0);
+    for (size_t i = 0; passed && i < readers; ++i) {
+      passed = wait_for_owner(*listeners[i], begin[i], phases[p].owner,
+                              first[i]);
+    }
+    ACE_OS::sleep(phase_hold);
+    for (size_t i = 0; passed && i < readers; ++i) {
+      passed = only_owner(*listeners[i], first[i], phases[p].owner);
+    }
+    if (!passed) {
+      cerr << "ERROR: run_test: phase " << p << " failed" << endl;
+    }
+  }
+
+  writer1.stop();
+  writer2.stop();
+  writer1.wait();
+  writer2.wait();
+  if (writer1.failed() || writer2.failed()) {
+    passed = false;
+  }
+
+  for (size_t i = 0; i < readers; ++i) {
+    drs[i]->set_listener(0, NO_STATUS_MASK);
+  }
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in OwnershipSwitchTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
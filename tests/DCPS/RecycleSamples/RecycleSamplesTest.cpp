@@ -0,0 +1,234 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/DataReaderImpl.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_string.h"
+
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+const CORBA::Long rounds = 10;
+
+// The member sizes of consecutive samples grow and shrink, including to
+// empty, so recycled samples are demarshaled into members both larger
+// and smaller than the new values.
+const CORBA::ULong sizes[] = {50, 3, 0, 200, 10, 1};
+const CORBA::Long samples_per_round = sizeof(sizes) / sizeof(sizes[0]);
+
+Message make_sample(CORBA::Long iteration)
+{
+  const CORBA::ULong size = sizes[iteration % samples_per_round];
+  const char c = static_cast<char>('a' + iteration % 26);
+  Message msg;
+  msg.key = 1;
+  msg.iteration = iteration;
+  msg.text = string(size, c).c_str();
+  msg.values.length(size / 2);
+  for (CORBA::ULong i = 0; i < msg.values.length(); ++i) {
+    msg.values[i] = iteration * 1000 + static_cast<CORBA::Long>(i);
+  }
+  msg.names.length(size % 7);
+  for (CORBA::ULong i = 0; i < msg.names.length(); ++i) {
+    msg.names[i] = string(i + 1 + size % 5, c).c_str();
+  }
+  return msg;
+}
+
+// Compare every member, a stale member of a recycled sample shows up as
+// a wrong length or value.
+bool check_sample(const Message& msg)
+{
+  const Message expected = make_sample(msg.iteration);
+  bool same = msg.key == expected.key
+    && string(msg.text.in()) == expected.text.in()
+    && msg.values.length() == expected.values.length()
+    && msg.names.length() == expected.names.length();
+  for (CORBA::ULong i = 0; same && i < msg.values.length(); ++i) {
+    same = msg.values[i] == expected.values[i];
+  }
+  for (CORBA::ULong i = 0; same && i < msg.names.length(); ++i) {
+    same = string(msg.names[i].in()) == expected.names[i].in();
+  }
+  if (!same) {
+    cerr << "ERROR: check_sample: iteration " << msg.iteration
+         << " has text length " << ACE_OS::strlen(msg.text.in())
+         << ", " << msg.values.length() << " values and "
+         << msg.names.length() << " names" << endl;
+  }
+  return same;
+}
+
+bool wait_for_match(const DataWriter_var& dw)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < 1) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_match: timed out" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+// Take the samples of iterations [first, first + count), alternating
+// between loans, which are returned, and copies.
+bool take_samples(const DataReader_var& dr, CORBA::Long first,
+                  CORBA::Long count)
+{
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  ReadCondition_var rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(rc);
+
+  bool passed = true;
+  CORBA::Long next = first;
+  bool loan = first / samples_per_round % 2 == 0;
+  while (next < first + count) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: take_samples: got " << next - first << " of "
+           << count << " samples" << endl;
+      passed = false;
+      break;
+    }
+    MessageSeq data;
+    SampleInfoSeq info;
+    if (!loan) {
+      data.length(samples_per_round);
+      info.length(samples_per_round);
+    }
+    while (mdr->take_w_condition(data, info, loan ? LENGTH_UNLIMITED
+             : samples_per_round, rc) == RETCODE_OK) {
+      for (CORBA::ULong i = 0; i < data.length(); ++i) {
+        if (!info[i].valid_data) {
+          continue;
+        }
+        if (data[i].iteration != next) {
+          cerr << "ERROR: take_samples: expected iteration " << next
+               << ", got " << data[i].iteration << endl;
+          passed = false;
+        }
+        passed &= check_sample(data[i]);
+        ++next;
+      }
+      if (loan) {
+        mdr->return_loan(data, info);
+      }
+    }
+  }
+
+  ws->detach_condition(rc);
+  dr->delete_readcondition(rc);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("RecycleSamples", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  // The subscriber doesn't enable its readers, recycle_samples() must be
+  // set before enable().
+  SubscriberQos sub_qos;
+  dp->get_default_subscriber_qos(sub_qos);
+  sub_qos.entity_factory.autoenable_created_entities = false;
+  Subscriber_var sub = dp->create_subscriber(sub_qos, 0, DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderImpl* const dr_impl = dynamic_cast<DataReaderImpl*>(dr.in());
+  if (!dr_impl) {
+    cerr << "ERROR: run_test: reader setup failed" << endl;
+    return 1;
+  }
+  dr_impl->recycle_samples() = true;
+  if (sub->enable() != RETCODE_OK || dr->enable() != RETCODE_OK) {
+    cerr << "ERROR: run_test: enable failed" << endl;
+    return 1;
+  }
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  if (!dw || !wait_for_match(dw)) {
+    cerr << "ERROR: run_test: writer setup failed" << endl;
+    return 1;
+  }
+
+  // Each round takes all of its samples, so they are released and the
+  // next round is demarshaled into them.
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  bool passed = true;
+  for (CORBA::Long r = 0; r < rounds; ++r) {
+    const CORBA::Long first = r * samples_per_round;
+    for (CORBA::Long i = first; i < first + samples_per_round; ++i) {
+      if (mdw->write(make_sample(i), HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: run_test: write failed" << endl;
+        passed = false;
+      }
+    }
+    passed &= take_samples(dr, first, samples_per_round);
+  }
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in RecycleSamplesTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
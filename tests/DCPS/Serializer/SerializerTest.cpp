@@ -1,6 +1,8 @@
 #include "dds/DCPS/Serializer.h"
 #include "dds/DCPS/Definitions.h"
 
+#include "tao/CORBA_String.h"
+
 #include "ace/ACE.h"
 #include "ace/Arg_Shifter.h"
 #include "ace/Get_Opt.h"
@@ -480,6 +482,36 @@ runTest(const Values& expected, const ArrayValues& expectedArray,
 bool runAlignmentTest();
 bool runAlignmentResetTest();
 
+bool
+runStringReuseTest()
+{
+  std::cout << "\n\n*** String reuse" << std::endl;
+  ACE_Message_Block mb(128);
+  Serializer out(&mb, false, Serializer::ALIGN_CDR);
+  out << "short";
+  out << "a value that doesn't fit";
+
+  Serializer in(&mb, false, Serializer::ALIGN_CDR);
+  ACE_CDR::Char* const previous = CORBA::string_dup("longer previous value");
+  ACE_CDR::Char* str = previous;
+  bool ok = true;
+
+  // fits in the previous value, which is overwritten
+  in.read_string(str);
+  if (!in.good_bit() || str != previous || ACE_OS::strcmp(str, "short")) {
+    std::cout << "ERROR: string not read into the previous value" << std::endl;
+    ok = false;
+  }
+
+  in.read_string(str);
+  if (!in.good_bit() || ACE_OS::strcmp(str, "a value that doesn't fit")) {
+    std::cout << "ERROR: string not read into a new value" << std::endl;
+    ok = false;
+  }
+  CORBA::string_free(str);
+  return ok;
+}
+
 int
 ACE_TMAIN(int, ACE_TCHAR*[])
 {
@@ -568,7 +600,7 @@ ACE_TMAIN(int, ACE_TCHAR*[])
   runTest(expected, expectedArray, true /*swap*/, align);
   runTest(expected, expectedArray, false /*swap*/, align);
 
-  if (!runAlignmentTest() || !runAlignmentResetTest()) {
+  if (!runAlignmentTest() || !runAlignmentResetTest() || !runStringReuseTest()) {
     failed = true;
   }
 
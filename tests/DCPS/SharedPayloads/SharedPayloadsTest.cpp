@@ -0,0 +1,239 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "dds/DCPS/transport/framework/TransportRegistry.h"
+#include "dds/DCPS/transport/shmem/ShmemTransport.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+# include "dds/DCPS/transport/shmem/Shmem.h"
+#endif
+
+#include "ace/Arg_Shifter.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include <iostream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+const Duration_t exit_wait_time = {30, 0};
+
+// The last sample is only written once the others were acknowledged, so
+// writing it releases every payload the subscribers are done with.
+const CORBA::Long samples = 40;
+
+string text_for(CORBA::Long iteration)
+{
+  return string(iteration % 5 * 1000 + 1, static_cast<char>('a' + iteration % 26));
+}
+
+// Wait until the writer is matched with count readers
+bool wait_for_readers(const DataWriter_var& dw, CORBA::Long count,
+                      const Duration_t& timeout)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count != count) {
+    ConditionSeq active;
+    if (ws->wait(active, timeout) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_readers: " << status.current_count
+           << " of " << count << " readers matched" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+bool write_sample(const MessageDataWriter_var& mdw, CORBA::Long iteration)
+{
+  Message sample;
+  sample.from = "shared payloads writer";
+  sample.key = 1;
+  sample.iteration = iteration;
+  sample.text = text_for(iteration).c_str();
+  if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+    cerr << "ERROR: write_sample: write failed" << endl;
+    return false;
+  }
+  return true;
+}
+
+bool run_publisher(const DomainParticipant_var& dp, const Topic_var& topic,
+                   CORBA::Long subscribers)
+{
+  ShmemTransport* const shmem = dynamic_cast<ShmemTransport*>(
+    TheTransportRegistry->get_inst("shmem1")->impl());
+  if (!shmem) {
+    cerr << "ERROR: run_publisher: no shmem transport" << endl;
+    return false;
+  }
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  if (!dw || !wait_for_readers(dw, subscribers, max_wait_time)) {
+    cerr << "ERROR: run_publisher: setup failed" << endl;
+    return false;
+  }
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  bool passed = true;
+  for (CORBA::Long i = 0; i < samples - 1; ++i) {
+    passed &= write_sample(mdw, i);
+  }
+  if (dw->wait_for_acknowledgments(max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: run_publisher: wait_for_acknowledgments failed" << endl;
+    passed = false;
+  }
+
+  // Each sample was copied to the pool once, for the first peer
+  if (shmem->payloads_reused() < size_t(samples - 1) * (subscribers - 1)) {
+    cerr << "ERROR: run_publisher: payloads were reused "
+         << shmem->payloads_reused() << " times" << endl;
+    passed = false;
+  }
+
+  // Every peer marked the acknowledged samples RECV_DONE, sending the last
+  // sample frees them and only its own payload is left.
+  passed &= write_sample(mdw, samples - 1);
+  if (shmem->shared_payloads() != 1) {
+    cerr << "ERROR: run_publisher: " << shmem->shared_payloads()
+         << " payloads are still in the pool" << endl;
+    passed = false;
+  }
+
+  // The subscribers exit once they got every sample
+  passed &= wait_for_readers(dw, 0, exit_wait_time);
+  return passed;
+}
+
+bool run_subscriber(const DomainParticipant_var& dp, const Topic_var& topic)
+{
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  if (!dr) {
+    cerr << "ERROR: run_subscriber: setup failed" << endl;
+    return false;
+  }
+
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  ReadCondition_var rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(rc);
+
+  bool passed = true;
+  CORBA::Long received = 0;
+  while (received < samples) {
+    ConditionSeq active;
+    if (ws->wait(active, exit_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: run_subscriber: got " << received << " of "
+           << samples << " samples" << endl;
+      passed = false;
+      break;
+    }
+    MessageSeq data;
+    SampleInfoSeq info;
+    while (mdr->take_w_condition(data, info, LENGTH_UNLIMITED, rc)
+           == RETCODE_OK) {
+      for (CORBA::ULong i = 0; i < data.length(); ++i) {
+        if (!info[i].valid_data) {
+          continue;
+        }
+        if (data[i].iteration != received
+            || text_for(received) != data[i].text.in()) {
+          cerr << "ERROR: run_subscriber: expected iteration " << received
+               << ", got " << data[i].iteration << endl;
+          passed = false;
+        }
+        ++received;
+      }
+      mdr->return_loan(data, info);
+    }
+  }
+
+  ws->detach_condition(rc);
+  dr->delete_readcondition(rc);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  bool subscriber = false;
+  CORBA::Long subscribers = 1;
+  ACE_Arg_Shifter arg_shifter(argc, argv);
+  while (arg_shifter.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if (arg_shifter.cur_arg_strncasecmp(ACE_TEXT("-s")) == 0) {
+      subscriber = true;
+      arg_shifter.consume_arg();
+    } else if ((arg = arg_shifter.get_the_parameter(ACE_TEXT("-n"))) != 0) {
+      subscribers = ACE_OS::atoi(arg);
+      arg_shifter.consume_arg();
+    } else {
+      arg_shifter.ignore_arg();
+    }
+  }
+
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("SharedPayloads", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  const bool passed = subscriber ? run_subscriber(dp, topic)
+    : run_publisher(dp, topic, subscribers);
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in SharedPayloadsTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
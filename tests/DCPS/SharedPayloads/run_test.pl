@@ -0,0 +1,45 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $opts = '-DCPSConfigFile shmem.ini';
+my $subscribers = 2;
+
+if (scalar @ARGV && $ARGV[0] =~ /^-d/i) {
+  $opts .= " -DCPSTransportDebugLevel 6 -DCPSDebugLevel 10";
+}
+
+my @subs;
+for my $i (1 .. $subscribers) {
+  my $sub = PerlDDS::create_process('SharedPayloadsTest', "$opts -s");
+  print STDERR $sub->CommandLine() . "\n";
+  $sub->Spawn();
+  push(@subs, $sub);
+}
+
+my $pub = PerlDDS::create_process('SharedPayloadsTest',
+                                  "$opts -n $subscribers");
+print STDERR $pub->CommandLine() . "\n";
+my $status = 0;
+my $result = $pub->SpawnWaitKill(60);
+if ($result != 0) {
+  print STDERR "ERROR: publisher returned $result\n";
+  $status = 1;
+}
+
+for my $sub (@subs) {
+  $result = $sub->WaitKill(15);
+  if ($result != 0) {
+    print STDERR "ERROR: subscriber returned $result\n";
+    $status = 1;
+  }
+}
+
+exit $status;
@@ -0,0 +1,316 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/LocalObject.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "dds/DCPS/transport/framework/TransportRegistry.h"
+#include "dds/DCPS/transport/rtps_udp/RtpsUdpInst.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Task.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// Participants created and deleted while the writer keeps writing
+const int participants = 10;
+
+// Samples each of them must get before it is deleted
+const int samples_per_participant = 10;
+
+class CountingListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener>
+{
+public:
+  CountingListener()
+    : samples_(0)
+  {}
+
+  virtual void on_requested_deadline_missed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedDeadlineMissedStatus & /*status*/) {}
+
+  virtual void on_requested_incompatible_qos(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::RequestedIncompatibleQosStatus & /*status*/) {}
+
+  virtual void on_liveliness_changed(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::LivelinessChangedStatus & /*status*/) {}
+
+  virtual void on_subscription_matched(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SubscriptionMatchedStatus & /*status*/) {}
+
+  virtual void on_sample_rejected(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleRejectedStatus& /*status*/) {}
+
+  virtual void on_data_available(DDS::DataReader_ptr reader)
+  {
+    MessageDataReader_var mdr = MessageDataReader::_narrow(reader);
+    MessageSeq data;
+    SampleInfoSeq info;
+    if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                  ANY_VIEW_STATE, ANY_INSTANCE_STATE) != RETCODE_OK) {
+      return;
+    }
+
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      if (info[i].valid_data) {
+        ++samples_;
+      }
+    }
+    mdr->return_loan(data, info);
+  }
+
+  virtual void on_sample_lost(
+    DDS::DataReader_ptr /*reader*/,
+    const DDS::SampleLostStatus& /*status*/) {}
+
+  int samples() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, 0);
+    return samples_;
+  }
+
+private:
+  mutable ACE_Thread_Mutex lock_;
+  int samples_;
+};
+
+// Writes until stopped
+class WriterTask : public ACE_Task_Base {
+public:
+  explicit WriterTask(const DataWriter_var& dw)
+    : dw_(MessageDataWriter::_narrow(dw))
+    , stop_(false)
+    , failed_(false)
+  {}
+
+  int svc()
+  {
+    Message sample;
+    sample.from = "shared reactor writer";
+    sample.iteration = 0;
+    sample.text = "traffic";
+    while (!stopped()) {
+      sample.key = sample.iteration % 4;
+      if (dw_->write(sample, HANDLE_NIL) != RETCODE_OK) {
+        cerr << "ERROR: WriterTask: write failed" << endl;
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, -1);
+        failed_ = true;
+        return -1;
+      }
+      ++sample.iteration;
+      ACE_OS::sleep(ACE_Time_Value(0, 2000));
+    }
+    return 0;
+  }
+
+  void stop()
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+    stop_ = true;
+  }
+
+  bool failed() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return failed_;
+  }
+
+private:
+  bool stopped() const
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, true);
+    return stop_;
+  }
+
+  MessageDataWriter_var dw_;
+  mutable ACE_Thread_Mutex lock_;
+  bool stop_;
+  bool failed_;
+};
+
+// Participant with its own rtps_udp transport on the shared reactor
+struct TestParticipant {
+  TestParticipant(DomainParticipantFactory_var dpf, const string& name)
+    : dpf_(dpf)
+  {
+    inst_ = TheTransportRegistry->create_inst("inst_" + name, "rtps_udp");
+    RtpsUdpInst* const rtps_inst = dynamic_cast<RtpsUdpInst*>(inst_.in());
+    if (rtps_inst) {
+      rtps_inst->use_multicast_ = false;
+      rtps_inst->shared_reactor_ = true;
+    }
+    config_ = TheTransportRegistry->create_config("config_" + name);
+    config_->instances_.push_back(inst_);
+
+    dp_ = dpf_->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                                   DEFAULT_STATUS_MASK);
+    if (dp_) {
+      TheTransportRegistry->bind_config(config_, dp_);
+    }
+  }
+
+  // Deletes the participant, then shuts its transport down while the
+  // shared reactor thread keeps serving the other participants.
+  ~TestParticipant()
+  {
+    if (dp_) {
+      dp_->delete_contained_entities();
+      dpf_->delete_participant(dp_);
+    }
+    TheTransportRegistry->remove_config(config_);
+    TheTransportRegistry->remove_inst(inst_);
+  }
+
+  Topic_var topic() const
+  {
+    MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+    ts->register_type(dp_, "");
+    CORBA::String_var type_name = ts->get_type_name();
+    return dp_->create_topic("SharedReactor", type_name, TOPIC_QOS_DEFAULT,
+                             0, DEFAULT_STATUS_MASK);
+  }
+
+  DomainParticipantFactory_var dpf_;
+  TransportInst_rch inst_;
+  TransportConfig_rch config_;
+  DomainParticipant_var dp_;
+};
+
+DataReader_var create_reader(const TestParticipant& part,
+                             const DataReaderListener_var& listener)
+{
+  Topic_var topic = part.topic();
+  Subscriber_var sub = part.dp_->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                                   0, DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  return sub->create_datareader(topic, dr_qos, listener,
+                                DATA_AVAILABLE_STATUS);
+}
+
+// Poll until the listener got at least samples samples
+bool wait_for_samples(const CountingListener& listener, int samples)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+  while (listener.samples() < samples) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      cerr << "ERROR: wait_for_samples: got " << listener.samples()
+           << " of " << samples << " samples" << endl;
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return true;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  // The writer and a reader that outlive all the other participants
+  TestParticipant pub_part(dpf, "pub");
+  TestParticipant sub_part(dpf, "sub");
+  if (!pub_part.dp_ || !sub_part.dp_) {
+    cerr << "ERROR: run_test: participant setup failed" << endl;
+    return 1;
+  }
+  Topic_var topic = pub_part.topic();
+  Publisher_var pub = pub_part.dp_->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                                     0, DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+  DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+  CountingListener* const sub_listener_impl = new CountingListener;
+  DataReaderListener_var sub_listener(sub_listener_impl);
+  DataReader_var sub_dr = create_reader(sub_part, sub_listener);
+  if (!dw || !sub_dr) {
+    cerr << "ERROR: run_test: writer or reader setup failed" << endl;
+    return 1;
+  }
+
+  WriterTask writer(dw);
+  writer.activate(THR_NEW_LWP | THR_JOINABLE);
+
+  bool passed = wait_for_samples(*sub_listener_impl, samples_per_participant);
+  for (int i = 0; passed && i < participants; ++i) {
+    ostringstream name;
+    name << "churn" << i;
+    TestParticipant part(dpf, name.str());
+    if (!part.dp_) {
+      cerr << "ERROR: run_test: participant " << i << " setup failed" << endl;
+      passed = false;
+      break;
+    }
+    CountingListener* const listener_impl = new CountingListener;
+    DataReaderListener_var listener(listener_impl);
+    DataReader_var dr = create_reader(part, listener);
+    if (!dr || !wait_for_samples(*listener_impl, samples_per_participant)) {
+      cerr << "ERROR: run_test: participant " << i << " got no data" << endl;
+      passed = false;
+    }
+    if (dr) {
+      dr->set_listener(0, NO_STATUS_MASK);
+    }
+  }
+
+  // The participants that stayed still exchange data
+  const int before = sub_listener_impl->samples();
+  if (passed && !wait_for_samples(*sub_listener_impl,
+                                  before + samples_per_participant)) {
+    cerr << "ERROR: run_test: traffic stopped after the participants "
+         << "were deleted" << endl;
+    passed = false;
+  }
+
+  writer.stop();
+  writer.wait();
+  if (writer.failed()) {
+    passed = false;
+  }
+
+  sub_dr->set_listener(0, NO_STATUS_MASK);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in SharedReactorTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
@@ -0,0 +1,273 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "dds/DCPS/DataReaderImpl.h"
+#include "dds/DCPS/RTPS/BaseMessageUtils.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <string>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// Must match the topic_multicast_groups entries of rtps_disc.ini: topic t
+// has group 239.255.2.(t + 1).  The last replaced_count topics get readers
+// only once the readers of as many others are deleted.
+const int topic_count = 24;
+const int replaced_count = 4;
+const CORBA::Long samples_per_topic = 10;
+
+struct TopicEntities {
+  DataWriter_var dw;
+  DataReader_var dr;
+};
+
+bool wait_for_match(const DataWriter_var& dw)
+{
+  StatusCondition_var dw_sc = dw->get_statuscondition();
+  dw_sc->set_enabled_statuses(PUBLICATION_MATCHED_STATUS);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(dw_sc);
+  PublicationMatchedStatus status = PublicationMatchedStatus();
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < 1) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: wait_for_match: timed out" << endl;
+      ws->detach_condition(dw_sc);
+      return false;
+    }
+  }
+  ws->detach_condition(dw_sc);
+  return true;
+}
+
+string topic_name_of(int t)
+{
+  ostringstream topic_name;
+  topic_name << "TopicMulticast" << t;
+  return topic_name.str();
+}
+
+// The multicast group the reader advertises
+ACE_INET_Addr advertised_group(const DataReader_var& dr)
+{
+  DataReaderImpl* const dr_impl = dynamic_cast<DataReaderImpl*>(dr.in());
+  if (!dr_impl) {
+    return ACE_INET_Addr();
+  }
+  const TransportLocatorSeq& info = dr_impl->connection_info();
+  for (CORBA::ULong i = 0; i < info.length(); ++i) {
+    LocatorSeq locators;
+    if (string(info[i].transport_type.in()) != "rtps_udp"
+        || OpenDDS::RTPS::blob_to_locators(info[i].data, locators)
+           != RETCODE_OK) {
+      continue;
+    }
+    for (CORBA::ULong j = 0; j < locators.length(); ++j) {
+      ACE_INET_Addr addr;
+      if (OpenDDS::RTPS::locator_to_address(addr, locators[j], false) == 0
+          && addr.is_multicast()) {
+        return addr;
+      }
+    }
+  }
+  return ACE_INET_Addr();
+}
+
+// The reader of topic t advertises the topic's own group
+bool has_topic_group(const DataReader_var& dr, int t)
+{
+  ostringstream expected;
+  expected << "239.255.2." << t + 1;
+  const ACE_INET_Addr group = advertised_group(dr);
+  if (group.get_ip_address()
+      != ACE_INET_Addr(u_short(0), expected.str().c_str()).get_ip_address()) {
+    cerr << "ERROR: has_topic_group: " << topic_name_of(t)
+         << " advertises " << group.get_host_addr() << ", not "
+         << expected.str() << endl;
+    return false;
+  }
+  return true;
+}
+
+bool write_samples(const DataWriter_var& dw, int t)
+{
+  if (!wait_for_match(dw)) {
+    return false;
+  }
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  const string topic_name = topic_name_of(t);
+  Message sample;
+  sample.from = "topic multicast writer";
+  sample.key = t;
+  sample.text = topic_name.c_str();
+  for (CORBA::Long i = 0; i < samples_per_topic; ++i) {
+    sample.iteration = i;
+    if (mdw->write(sample, HANDLE_NIL) != RETCODE_OK) {
+      cerr << "ERROR: write_samples: " << topic_name << " write failed"
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Take samples until all of them arrived, in order.
+bool take_samples(const DataReader_var& dr, const string& topic_name)
+{
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  ReadCondition_var rc = dr->create_readcondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ANY_INSTANCE_STATE);
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(rc);
+
+  bool passed = true;
+  CORBA::Long received = 0;
+  while (received < samples_per_topic) {
+    ConditionSeq active;
+    if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+      cerr << "ERROR: take_samples: " << topic_name << " got " << received
+           << " of " << samples_per_topic << " samples" << endl;
+      passed = false;
+      break;
+    }
+    MessageSeq data;
+    SampleInfoSeq info;
+    while (mdr->take_w_condition(data, info, LENGTH_UNLIMITED, rc)
+           == RETCODE_OK) {
+      for (CORBA::ULong i = 0; i < data.length(); ++i) {
+        if (!info[i].valid_data) {
+          continue;
+        }
+        if (data[i].iteration != received
+            || topic_name != data[i].text.in()) {
+          cerr << "ERROR: take_samples: " << topic_name
+               << " unexpected iteration " << data[i].iteration << endl;
+          passed = false;
+        }
+        ++received;
+      }
+      mdr->return_loan(data, info);
+    }
+  }
+
+  ws->detach_condition(rc);
+  dr->delete_readcondition(rc);
+  return passed;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dw_qos.reliability.kind = RELIABLE_RELIABILITY_QOS;
+
+  // Each topic has its own group, the readers of the groups that can't
+  // be joined advertise the shared group instead and still get the data.
+  bool passed = true;
+  TopicEntities entities[topic_count];
+  const int first_count = topic_count - replaced_count;
+  for (int t = 0; t < topic_count; ++t) {
+    Topic_var topic = dp->create_topic(topic_name_of(t).c_str(), type_name,
+                                       TOPIC_QOS_DEFAULT, 0,
+                                       DEFAULT_STATUS_MASK);
+    if (t < first_count) {
+      entities[t].dr = sub->create_datareader(topic, dr_qos, 0,
+                                              DEFAULT_STATUS_MASK);
+    }
+    entities[t].dw = pub->create_datawriter(topic, dw_qos, 0,
+                                            DEFAULT_STATUS_MASK);
+    if ((t < first_count && !entities[t].dr) || !entities[t].dw) {
+      cerr << "ERROR: run_test: " << topic_name_of(t) << " setup failed"
+           << endl;
+      passed = false;
+    }
+  }
+  if (!passed) {
+    dp->delete_contained_entities();
+    dpf->delete_participant(dp);
+    return 1;
+  }
+
+  for (int t = 0; t < first_count; ++t) {
+    passed &= write_samples(entities[t].dw, t);
+  }
+  for (int t = 0; t < first_count; ++t) {
+    passed &= take_samples(entities[t].dr, topic_name_of(t));
+  }
+
+  // Deleting the only reader of a topic leaves the topic's group, the
+  // readers of the remaining topics can then join their own groups.
+  for (int t = 0; t < replaced_count; ++t) {
+    passed &= has_topic_group(entities[t].dr, t);
+    sub->delete_datareader(entities[t].dr);
+    entities[t].dr = DataReader::_nil();
+  }
+  for (int t = first_count; t < topic_count; ++t) {
+    Topic_var topic = entities[t].dw->get_topic();
+    entities[t].dr = sub->create_datareader(topic, dr_qos, 0,
+                                            DEFAULT_STATUS_MASK);
+    if (!entities[t].dr) {
+      cerr << "ERROR: run_test: " << topic_name_of(t)
+           << " reader setup failed" << endl;
+      passed = false;
+      continue;
+    }
+    passed &= has_topic_group(entities[t].dr, t)
+      && write_samples(entities[t].dw, t)
+      && take_samples(entities[t].dr, topic_name_of(t));
+  }
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in TopicMulticastTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
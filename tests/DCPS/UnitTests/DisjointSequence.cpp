@@ -742,6 +742,36 @@ int ACE_TMAIN(int, ACE_TCHAR*[])
       TEST_CHECK(bitmap[0] == 0x003FF000);
       TEST_CHECK(bitmap[1] == 0x00000001);
     }
+
+    // Erasing values
+    {
+      DisjointSequence sequence;
+      sequence.insert(SequenceRange(1, 10));
+      sequence.insert(20);
+
+      // ASSERT erasing a missing value doesn't change the set:
+      TEST_CHECK(!sequence.erase(15));
+      TEST_CHECK(sequence.present_sequence_ranges().size() == 2);
+
+      // ASSERT erasing from the middle of a range splits it:
+      TEST_CHECK(sequence.erase(5));
+      TEST_CHECK(!sequence.contains(5));
+      TEST_CHECK(sequence.contains(4));
+      TEST_CHECK(sequence.contains(6));
+      TEST_CHECK(sequence.cumulative_ack() == SequenceNumber(4));
+      TEST_CHECK(sequence.present_sequence_ranges().size() == 3);
+
+      // ASSERT erasing the ends of ranges shrinks them:
+      TEST_CHECK(sequence.erase(1));
+      TEST_CHECK(sequence.erase(10));
+      TEST_CHECK(sequence.low() == SequenceNumber(2));
+      TEST_CHECK(!sequence.contains(10));
+
+      // ASSERT erasing a single value range removes it:
+      TEST_CHECK(sequence.erase(20));
+      TEST_CHECK(sequence.high() == SequenceNumber(9));
+      TEST_CHECK(sequence.present_sequence_ranges().size() == 2);
+    }
   }
   catch (std::runtime_error& err)
   {
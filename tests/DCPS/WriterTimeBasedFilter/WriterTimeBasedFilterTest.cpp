@@ -0,0 +1,180 @@
+#include "dds/DdsDcpsInfrastructureC.h"
+#include "dds/DCPS/WaitSet.h"
+#include "dds/DCPS/Service_Participant.h"
+#include "dds/DCPS/Marked_Default_Qos.h"
+#include "dds/DCPS/StaticIncludes.h"
+#include "dds/DCPS/Time_Helper.h"
+#include "MessengerTypeSupportImpl.h"
+
+#ifdef ACE_AS_STATIC_LIBS
+# include "dds/DCPS/RTPS/RtpsDiscovery.h"
+# include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
+#endif
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <iostream>
+using namespace std;
+using namespace DDS;
+using namespace OpenDDS::DCPS;
+using namespace Messenger;
+
+const Duration_t max_wait_time = {10, 0};
+
+// The reader's TIME_BASED_FILTER
+const Duration_t min_separation = {0, 200000000};
+
+// Time for the samples written last to reach the reader
+const ACE_Time_Value settle_time(0, 500000);
+
+bool wait_for_match(const DataWriter_var& dw)
+{
+  const ACE_Time_Value deadline =
+    ACE_OS::gettimeofday() + ACE_Time_Value(max_wait_time.sec, 0);
+  PublicationMatchedStatus status;
+  while (dw->get_publication_matched_status(status) == RETCODE_OK
+         && status.current_count < 1) {
+    if (ACE_OS::gettimeofday() > deadline) {
+      cerr << "ERROR: wait_for_match: reader not matched" << endl;
+      return false;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  return true;
+}
+
+// Writes count samples of one instance, interval apart.  Each sample has
+// source timestamp stamp, or the time it is written at if stamp is zero.
+bool write_samples(const MessageDataWriter_var& mdw, int count,
+                   const ACE_Time_Value& interval, const Time_t* stamp)
+{
+  Message sample;
+  sample.from = "writer";
+  sample.key = 1;
+  sample.text = "time based filter";
+  for (int i = 0; i < count; ++i) {
+    sample.iteration = i;
+    const ReturnCode_t ret = stamp
+      ? mdw->write_w_timestamp(sample, HANDLE_NIL, *stamp)
+      : mdw->write(sample, HANDLE_NIL);
+    if (ret != RETCODE_OK) {
+      cerr << "ERROR: write_samples: write failed" << endl;
+      return false;
+    }
+    ACE_OS::sleep(interval);
+  }
+  ACE_OS::sleep(settle_time);
+  return true;
+}
+
+// Takes everything the reader has and returns the number of valid samples
+int take_samples(const DataReader_var& dr)
+{
+  MessageDataReader_var mdr = MessageDataReader::_narrow(dr);
+  MessageSeq data;
+  SampleInfoSeq info;
+  int samples = 0;
+  if (mdr->take(data, info, LENGTH_UNLIMITED, ANY_SAMPLE_STATE,
+                ANY_VIEW_STATE, ANY_INSTANCE_STATE) == RETCODE_OK) {
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      if (info[i].valid_data) {
+        ++samples;
+      }
+    }
+    mdr->return_loan(data, info);
+  }
+  return samples;
+}
+
+bool check(const char* phase, int samples, int min, int max)
+{
+  if (samples < min || samples > max) {
+    cerr << "ERROR: " << phase << ": got " << samples
+         << " samples, expected " << min << " to " << max << endl;
+    return false;
+  }
+  return true;
+}
+
+int run_test(int argc, ACE_TCHAR *argv[])
+{
+  DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  DomainParticipant_var dp =
+    dpf->create_participant(23, PARTICIPANT_QOS_DEFAULT, 0,
+                            DEFAULT_STATUS_MASK);
+  MessageTypeSupport_var ts = new MessageTypeSupportImpl;
+  ts->register_type(dp, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  Topic_var topic = dp->create_topic("WriterTimeBasedFilter", type_name,
+                                     TOPIC_QOS_DEFAULT, 0,
+                                     DEFAULT_STATUS_MASK);
+
+  // A BEST_EFFORT reader with a TIME_BASED_FILTER, the writer filters
+  // for it.
+  Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+                                             DEFAULT_STATUS_MASK);
+  DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.history.kind = KEEP_ALL_HISTORY_QOS;
+  dr_qos.reliability.kind = BEST_EFFORT_RELIABILITY_QOS;
+  dr_qos.time_based_filter.minimum_separation = min_separation;
+  DataReader_var dr = sub->create_datareader(topic, dr_qos, 0,
+                                             DEFAULT_STATUS_MASK);
+
+  Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+                                           DEFAULT_STATUS_MASK);
+  DataWriter_var dw = pub->create_datawriter(topic, DATAWRITER_QOS_DEFAULT,
+                                             0, DEFAULT_STATUS_MASK);
+  if (!dr || !dw || !wait_for_match(dw)) {
+    cerr << "ERROR: run_test: setup failed" << endl;
+    return 1;
+  }
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  const ACE_Time_Value separation = duration_to_time_value(min_separation);
+  bool passed = true;
+
+  // Samples further apart than the filter period are all delivered
+  const int spaced = 5;
+  passed = write_samples(mdw, spaced, separation + ACE_Time_Value(0, 100000), 0)
+    && check("spaced", take_samples(dr), spaced, spaced) && passed;
+
+  // A burst of 1 s is thinned out to about one sample per period, but
+  // the writer must not drop the ones the reader would accept.
+  const ACE_Time_Value burst_interval(0, 10000);
+  const int burst = 100;
+  const int periods = static_cast<int>(
+    (burst_interval * burst).msec() / separation.msec());
+  passed = write_samples(mdw, burst, burst_interval, 0)
+    && check("burst", take_samples(dr), periods / 2, periods + 1) && passed;
+
+  // The writer separates samples by their source timestamp: samples
+  // written well apart with the same timestamp are sent only once.
+  ACE_OS::sleep(separation);
+  const Time_t stamp = time_value_to_time(ACE_OS::gettimeofday());
+  passed = write_samples(mdw, spaced, separation + ACE_Time_Value(0, 100000),
+                         &stamp)
+    && check("source timestamp", take_samples(dr), 1, 1) && passed;
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return passed ? 0 : 1;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int ret = 1;
+  try
+  {
+    ret = run_test(argc, argv);
+  }
+  catch (const CORBA::BAD_PARAM& ex) {
+    ex._tao_print_exception("Exception caught in WriterTimeBasedFilterTest.cpp:");
+    return 1;
+  }
+
+  // cleanup
+  TheServiceParticipant->shutdown ();
+  ACE_Thread_Manager::instance()->wait();
+  return ret;
+}
@@ -1,4 +1,5 @@
 #include "../Idl/FaceMessage_TS.hpp"
+#include "dds/FACE/FaceTSS.h"
 
 #ifdef ACE_AS_STATIC_LIBS
 # include "dds/DCPS/RTPS/RtpsDiscovery.h"
@@ -78,11 +79,20 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
   FACE::TS::Send_Message(pub_connId, FACE::INF_TIME_VALUE, txn, msg, pub_max_msg_size, status);
   if (status != FACE::RC_NO_ERROR) return static_cast<int>(status);
 
+  ACE_DEBUG((LM_INFO, "Publisher: about to send_message() with a registered instance\n"));
+  DDS::InstanceHandle_t handle;
+  OpenDDS::FaceTSS::register_instance(pub_connId, msg, handle, status);
+  if (status != FACE::RC_NO_ERROR) return static_cast<int>(status);
+  msg.count = 1;
+  OpenDDS::FaceTSS::send_message(pub_connId, FACE::INF_TIME_VALUE, msg, handle,
+                                 pub_max_msg_size, status);
+  if (status != FACE::RC_NO_ERROR) return static_cast<int>(status);
+
   if (useCallback) {
     ACE_OS::sleep(5);
-    if (!callbackHappened || callback_count != 1) {
+    if (!callbackHappened || callback_count != 2) {
       ACE_ERROR((LM_ERROR, "ERROR: number callbacks seen incorrect (seen: %d "
-        "expected: 1)\n", callback_count));
+        "expected: 2)\n", callback_count));
       testPassed = false;
     }
     FACE::TS::Unregister_Callback(connId, status);
@@ -95,6 +105,23 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     FACE::TS::Receive_Message(connId, timeout, txn, msg, max_msg_size, status);
     if (status != FACE::RC_NO_ERROR) return static_cast<int>(status);
     ACE_DEBUG((LM_INFO, "%C\t%d\n", msg.text.in(), msg.count));
+
+    // A zero timeout returns TIMED_OUT until the second message arrives,
+    // and the message once it has
+    for (int i = 0; i < 50; ++i) {
+      FACE::TS::Receive_Message(connId, 0, txn, msg, max_msg_size, status);
+      if (status != FACE::TIMED_OUT) {
+        break;
+      }
+      ACE_OS::sleep(ACE_Time_Value(0, 100000));
+    }
+    if (status != FACE::RC_NO_ERROR) return static_cast<int>(status);
+    ACE_DEBUG((LM_INFO, "%C\t%d\n", msg.text.in(), msg.count));
+    if (msg.count != 1) {
+      ACE_ERROR((LM_ERROR, "ERROR: unexpected count %d (expected: 1)\n",
+                 msg.count));
+      testPassed = false;
+    }
   }
 
   FACE::CONNECTION_NAME_TYPE name = {};
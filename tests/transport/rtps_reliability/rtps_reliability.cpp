@@ -2,6 +2,8 @@
 // OpenDDS transport implementation.
 
 #include "dds/DCPS/transport/rtps_udp/RtpsUdpInst.h"
+#include "dds/DCPS/transport/rtps_udp/RtpsUdpDataLink.h"
+#include "dds/DCPS/transport/rtps_udp/RtpsUdpReceiveStrategy.h"
 #ifdef ACE_AS_STATIC_LIBS
 #include "dds/DCPS/transport/rtps_udp/RtpsUdp.h"
 #endif
@@ -30,11 +32,13 @@
 #include <ace/Thread_Manager.h>
 #include <ace/Reactor.h>
 #include <ace/SOCK_Dgram.h>
+#include <ace/OS_NS_sys_time.h>
 
 #include <cstdlib>
 #include <typeinfo>
 #include <exception>
 #include <iostream>
+#include <vector>
 
 using namespace OpenDDS::DCPS;
 using namespace OpenDDS::RTPS;
@@ -105,10 +109,66 @@ struct SimpleDataReader: SimpleTC, TransportReceiveListener {
   bool have_frag_;
 };
 
+// Reader for the held data limit test, checks that samples are delivered
+// in order without duplicates.
+struct HeldDataReader: SimpleTC, TransportReceiveListener {
+  explicit HeldDataReader(const RepoId& sub_id)
+    : SimpleTC(sub_id), in_order_(true) {
+      RcObject::_add_ref();
+    }
+
+  void data_received(const ReceivedDataSample& sample)
+  {
+    const SequenceNumber& seq = sample.header_.sequence_;
+    ACE_DEBUG((LM_INFO, "HeldDataReader::data_received with seq#: %q\n",
+      seq.getValue()));
+    if (!recvd_.empty() && seq != recvd_.high() + 1) {
+      ACE_ERROR((LM_ERROR, "ERROR: HeldDataReader got seq#: %q after %q\n",
+        seq.getValue(), recvd_.high().getValue()));
+      in_order_ = false;
+    }
+    recvd_.insert(seq);
+  }
+
+  void notify_subscription_disconnected(const WriterIdSeq&) {}
+  void notify_subscription_reconnected(const WriterIdSeq&) {}
+  void notify_subscription_lost(const WriterIdSeq&) {}
+  void remove_associations(const WriterIdSeq&, bool) {}
+
+  DisjointSequence recvd_;
+  bool in_order_;
+};
+
+// Stands in for SEDP's default listener in the data filter test
+struct DefaultListener: TransportReceiveListener {
+  DefaultListener() : received_(0) { RcObject::_add_ref(); }
+
+  void data_received(const ReceivedDataSample&) { ++received_; }
+
+  void notify_subscription_disconnected(const WriterIdSeq&) {}
+  void notify_subscription_reconnected(const WriterIdSeq&) {}
+  void notify_subscription_lost(const WriterIdSeq&) {}
+  void remove_associations(const WriterIdSeq&, bool) {}
+
+  int received_;
+};
+
 class DDS_TEST
 {
 public:
 
+  static RtpsUdpDataLink* rtps_link(TransportClient& client)
+  {
+    DataLinkSet::MapType& links = client.links_.map();
+    return links.empty() ? 0
+      : dynamic_cast<RtpsUdpDataLink*>(links.begin()->second.in());
+  }
+
+  static RtpsUdpReceiveStrategy* receive_strategy(RtpsUdpDataLink& link)
+  {
+    return link.receive_strategy();
+  }
+
   static void list_set(DataSampleElement &element, SendStateDataSampleList &list)
   {
     list.head_ = &element;
@@ -177,7 +237,9 @@ struct TestParticipant: ACE_Event_Handler {
                   const OpenDDS::DCPS::GuidPrefix_t& prefix,
                   const OpenDDS::DCPS::EntityId_t& reader_ent)
     : sock_(sock), heartbeat_count_(0), acknack_count_(0), hbfrag_count_(0)
-    , recv_hdr_(), recv_mb_(64 * 1024), do_nack_(true), reader_ent_(reader_ent)
+    , recv_hdr_(), recv_mb_(64 * 1024), do_nack_(true), ack_all_(false)
+    , an_messages_(0), an_submessages_(0), data_count_(0)
+    , reader_ent_(reader_ent)
   {
     const Header hdr = {
       {'R', 'T', 'P', 'S'}, PROTOCOLVERSION, VENDORID_OPENDDS,
@@ -402,9 +464,10 @@ struct TestParticipant: ACE_Event_Handler {
     return send(mb, send_to);
   }
 
+  // Requests nack and, with num_bits up to 4, the samples that follow it
   bool send_an(const OpenDDS::DCPS::EntityId_t& writer,
                const SequenceNumber_t& nack, const ACE_INET_Addr& send_to,
-               bool set_bit_in_bitmap = true)
+               bool set_bit_in_bitmap = true, CORBA::ULong num_bits = 1)
   {
     LongSeq8 bitmap;
     bitmap.length(1);
@@ -417,14 +480,14 @@ struct TestParticipant: ACE_Event_Handler {
     an.readerId = reader_ent_;
     an.writerId = writer;
     an.readerSNState.bitmapBase = nack;
-    an.readerSNState.numBits = 1;
+    an.readerSNState.numBits = num_bits;
     an.readerSNState.bitmap = bitmap;
     an.count.value = ++acknack_count_;
 #else
     const AckNackSubmessage an = {
       {ACKNACK, FLAG_E, 0},
       reader_ent_, writer,
-      {nack, 1, bitmap},
+      {nack, num_bits, bitmap},
       {++acknack_count_}
     };
 #endif
@@ -453,6 +516,7 @@ struct TestParticipant: ACE_Event_Handler {
       return -1;
     }
     recv_mb_.wr_ptr(ret);
+    size_t acknacks = 0;
     Serializer ser(&recv_mb_, host_is_bigendian, Serializer::ALIGN_CDR);
     if (!(ser >> recv_hdr_)) {
       ACE_ERROR((LM_ERROR,
@@ -464,6 +528,10 @@ struct TestParticipant: ACE_Event_Handler {
       ser.swap_bytes((flags & FLAG_E) != ACE_CDR_BYTE_ORDER);
       switch (subm) {
       case ACKNACK:
+        if (acknacks++ == 0) {
+          ++an_messages_;
+        }
+        ++an_submessages_;
         if (!recv_an(ser, peer)) return false;
         break;
       case GAP:
@@ -594,6 +662,7 @@ struct TestParticipant: ACE_Event_Handler {
       return false;
     }
     ACE_DEBUG((LM_INFO, "recv_data() seq = %d\n", data.writerSN.low));
+    ++data_count_;
     if (data.smHeader.submessageLength) {
       ser.skip(data.smHeader.submessageLength - 20);
       // 20 == size of Data headers after smHeader (assuming no Inline QoS)
@@ -616,6 +685,12 @@ struct TestParticipant: ACE_Event_Handler {
     }
     ACE_DEBUG((LM_INFO, "recv_hb() first = %d last = %d\n",
                hb.firstSN.low, hb.lastSN.low));
+    if (ack_all_) {
+      hb_times_.push_back(ACE_OS::gettimeofday());
+      SequenceNumber_t next = hb.lastSN;
+      ++next.low;
+      return send_an(hb.writerId, next, peer, false);
+    }
     const bool flag_f = hb.smHeader.flags & 2;
     if (!flag_f && hb.firstSN.low == 1 && hb.lastSN.low == 1) {
       const SequenceNumber_t one = {0, 1};
@@ -640,6 +715,13 @@ struct TestParticipant: ACE_Event_Handler {
   Header hdr_, recv_hdr_;
   ACE_Message_Block recv_mb_;
   bool do_nack_;
+  /// Acknowledge everything a heartbeat announces and record when it came
+  bool ack_all_;
+  std::vector<ACE_Time_Value> hb_times_;
+  /// Received Messages with ACKNACKs, and the ACKNACKs in them
+  size_t an_messages_, an_submessages_;
+  /// Received DATA submessages
+  size_t data_count_;
   OpenDDS::DCPS::EntityId_t reader_ent_;
   DisjointSequence recvd_;
   static const ACE_CDR::UShort FRAG_SIZE = 1024;
@@ -711,6 +793,21 @@ void make_guids(OpenDDS::DCPS::GUID_t& writer1, OpenDDS::DCPS::GUID_t& reader1,
   reader2.entityId.entityKind = ENTITYKIND_USER_READER_WITH_KEY;
 }
 
+// Opens a socket for a test participant, addr is where it is reached
+bool open_test_socket(ACE_SOCK_Dgram& sock, ACE_INET_Addr& addr)
+{
+  if (!open_appropriate_socket_type(sock, addr)) {
+    return false;
+  }
+  sock.get_local_addr(addr);
+#ifdef OPENDDS_SAFETY_PROFILE
+  addr.set(addr.get_port_number(), "127.0.0.1");
+#else
+  addr.set(addr.get_port_number(), "localhost");
+#endif
+  return true;
+}
+
 void make_blob(const ACE_INET_Addr& part1_addr, ACE_Message_Block& mb_locator)
 {
   LocatorSeq part1_locators;
@@ -761,6 +858,358 @@ bool blob_to_addr(const TransportBLOB& blob, ACE_INET_Addr& addr)
   return true;
 }
 
+// With max_held_bytes_ set to hold two samples, the next sample the reader
+// needs must still be taken when the held samples fill the budget.
+bool run_held_limit_test(TestParticipant& part1, const RepoId& reader2,
+                         const AssociationData& part1_writer,
+                         const ACE_INET_Addr& part2_addr)
+{
+  ACE_DEBUG((LM_INFO, ">>> Starting test of held data limit\n"));
+  TransportInst_rch inst = TheTransportRegistry->get_inst("my_rtps");
+  RtpsUdpInst* rtps_inst = dynamic_cast<RtpsUdpInst*>(inst.in());
+  if (!rtps_inst) {
+    std::cerr << "ERROR: Could not cast to RtpsUdpInst\n";
+    return false;
+  }
+  rtps_inst->max_held_bytes_ = 16; // two of our 8 byte payloads
+
+  AssociationData part1_writer3 = part1_writer;
+  part1_writer3.remote_id_.entityId.entityKey[2] = 7;
+  part1_writer3.remote_durable_ = false;
+  RepoId reader3 = reader2;
+  reader3.entityId.entityKey[2] = 6;
+
+  HeldDataReader sdr3(reader3);
+  sdr3.enable_transport(true /*reliable*/, false /*durable*/);
+  if (!sdr3.associate(part1_writer3, false /*active*/)) {
+    ACE_DEBUG((LM_DEBUG,
+               "HeldDataReader(reader3) could not associate with writer3\n"));
+    return false;
+  }
+  const OpenDDS::DCPS::EntityId_t& writer3 = part1_writer3.remote_id_.entityId;
+  RtpsUdpDataLink* link = 0;
+  bool held_ok = true;
+
+  // Each step is a list of sequence numbers sent together.
+  // 1 is delivered, 3 and 5 fill the budget, 6 is above them and dropped.
+  // 2 is the next one needed: 5 is evicted for it, 2 and 3 are delivered.
+  // 6 and 7 fill the budget again, 8 is dropped.  5 is below the held
+  // samples and evicts 7, then 4 evicts 6 and 4 and 5 are delivered.
+  // The samples that were dropped or evicted are sent again last.
+  static const CORBA::ULong steps[][4] = {
+    {1, 3, 5, 6}, {2, 0, 0, 0}, {6, 7, 8, 0}, {5, 0, 0, 0}, {4, 0, 0, 0},
+    {6, 7, 8, 0}
+  };
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); ++i) {
+    for (size_t j = 0; j < 4 && steps[i][j]; ++j) {
+      const SequenceNumber_t seq = {0, steps[i][j]};
+      if (!part1.send_data(writer3, seq, part2_addr)) {
+        sdr3.disassociate(part1_writer3.remote_id_);
+        return false;
+      }
+    }
+    reactor_wait();
+    if (i == 0) {
+      // 3 and 5 are held, within the budget
+      link = DDS_TEST::rtps_link(sdr3);
+      const size_t held =
+        link ? link->held_bytes(reader3, part1_writer3.remote_id_) : 0;
+      if (held == 0 || held > rtps_inst->max_held_bytes_) {
+        ACE_ERROR((LM_ERROR, "ERROR: reader3 holds %B bytes, expected 1 to "
+                   "%B\n", held, rtps_inst->max_held_bytes_));
+        held_ok = false;
+      }
+    }
+  }
+
+  bool ok = held_ok;
+  if (link && link->held_bytes(reader3, part1_writer3.remote_id_) != 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: reader3 still holds samples\n"));
+    ok = false;
+  }
+  if (sdr3.recvd_.disjoint() || sdr3.recvd_.empty()
+      || sdr3.recvd_.low() != SequenceNumber()
+      || sdr3.recvd_.high() != SequenceNumber(8) || !sdr3.in_order_) {
+    ACE_ERROR((LM_ERROR, "ERROR: reader3 did not receive samples 1-8 in order\n"));
+    sdr3.recvd_.dump();
+    ok = false;
+  }
+
+  sdr3.disassociate(part1_writer3.remote_id_);
+  rtps_inst->max_held_bytes_ = 0;
+  return ok;
+}
+
+// DATA of writers that no local DataReader is associated with is dropped
+// before it's parsed, unless the link has a default listener or the writer
+// is a builtin one.
+bool run_data_filter_test(TestParticipant& part1, SimpleDataReader& sdr2,
+                          const RepoId& writer1, const ACE_INET_Addr& part2_addr)
+{
+  ACE_DEBUG((LM_INFO, ">>> Starting test of unmatched data filter\n"));
+  RtpsUdpDataLink* const link = DDS_TEST::rtps_link(sdr2);
+  if (!link) {
+    ACE_ERROR((LM_ERROR, "ERROR: reader2 has no RtpsUdpDataLink\n"));
+    return false;
+  }
+  RtpsUdpReceiveStrategy* const strategy = DDS_TEST::receive_strategy(*link);
+
+  OpenDDS::DCPS::EntityId_t unmatched = writer1.entityId;
+  unmatched.entityKey[2] = 9;
+  const SequenceNumber_t seq = {0, 1};
+  bool ok = true;
+
+  const size_t dropped = strategy->unmatched_data_dropped();
+  if (!part1.send_data(unmatched, seq, part2_addr)) {
+    return false;
+  }
+  reactor_wait();
+  if (strategy->unmatched_data_dropped() != dropped + 1) {
+    ACE_ERROR((LM_ERROR, "ERROR: DATA of an unmatched writer was not "
+               "dropped\n"));
+    ok = false;
+  }
+
+  if (!part1.send_data(ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER, seq,
+                       part2_addr)) {
+    return false;
+  }
+  reactor_wait();
+  if (strategy->unmatched_data_dropped() != dropped + 1) {
+    ACE_ERROR((LM_ERROR, "ERROR: DATA of a builtin writer was dropped\n"));
+    ok = false;
+  }
+
+  DefaultListener listener;
+  link->default_listener(listener);
+  if (!part1.send_data(unmatched, seq, part2_addr)) {
+    link->default_listener(TransportReceiveListener_wrch());
+    return false;
+  }
+  reactor_wait();
+  link->default_listener(TransportReceiveListener_wrch());
+  if (strategy->unmatched_data_dropped() != dropped + 1
+      || listener.received_ != 1) {
+    ACE_ERROR((LM_ERROR, "ERROR: DATA of an unmatched writer did not reach "
+               "the default listener\n"));
+    ok = false;
+  }
+  return ok;
+}
+
+// A writer acknowledged by all of its readers spaces its heartbeats out,
+// but never so far that its readers would consider it gone.
+bool run_heartbeat_backoff_test(TestParticipant& part1, SimpleDataWriter& sdw2,
+                                SequenceNumber& seq)
+{
+  ACE_DEBUG((LM_INFO, ">>> Starting test of heartbeat backoff\n"));
+  TransportInst_rch inst = TheTransportRegistry->get_inst("my_rtps");
+  RtpsUdpInst* rtps_inst = dynamic_cast<RtpsUdpInst*>(inst.in());
+  if (!rtps_inst) {
+    std::cerr << "ERROR: Could not cast to RtpsUdpInst\n";
+    return false;
+  }
+  // Far above the limit the link applies
+  rtps_inst->max_heartbeat_backoff_ = 100;
+  part1.ack_all_ = true;
+  part1.hb_times_.clear();
+
+  static const int seconds = 10;
+  sdw2.send_data(seq++);
+  for (int i = 0; i < seconds; ++i) {
+    reactor_wait();
+  }
+  part1.ack_all_ = false;
+  rtps_inst->max_heartbeat_backoff_ = 1;
+
+  const std::vector<ACE_Time_Value>& times = part1.hb_times_;
+  const ACE_Time_Value& period = rtps_inst->heartbeat_period_;
+  const size_t periods = seconds * 1000 / period.msec();
+  bool ok = true;
+  if (times.size() < 2 || times.size() > periods / 2) {
+    ACE_ERROR((LM_ERROR, "ERROR: got %B heartbeats in %B heartbeat periods\n",
+               times.size(), periods));
+    ok = false;
+  }
+  // 5 periods at most, plus one for the timer
+  for (size_t i = 1; i < times.size(); ++i) {
+    if (times[i] - times[i - 1] > 6 * period) {
+      ACE_ERROR((LM_ERROR, "ERROR: heartbeat %B came %d ms after the "
+                 "previous one\n", i, int((times[i] - times[i - 1]).msec())));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// ACKNACKs of several local readers to the same remote participant share
+// one RTPS Message.
+bool run_acknack_bundle_test(TestParticipant& part1, const RepoId& reader2,
+                             const AssociationData& part1_writer,
+                             const ACE_INET_Addr& part2_addr)
+{
+  ACE_DEBUG((LM_INFO, ">>> Starting test of ACKNACK bundling\n"));
+  AssociationData writer_a = part1_writer, writer_b = part1_writer;
+  writer_a.remote_id_.entityId.entityKey[2] = 11;
+  writer_a.remote_durable_ = false;
+  writer_b.remote_id_.entityId.entityKey[2] = 13;
+  writer_b.remote_durable_ = false;
+  RepoId reader_a = reader2, reader_b = reader2;
+  reader_a.entityId.entityKey[2] = 10;
+  reader_b.entityId.entityKey[2] = 12;
+
+  HeldDataReader sdr_a(reader_a), sdr_b(reader_b);
+  sdr_a.enable_transport(true /*reliable*/, false /*durable*/);
+  sdr_b.enable_transport(true /*reliable*/, false /*durable*/);
+  if (!sdr_a.associate(writer_a, false /*active*/)) {
+    ACE_DEBUG((LM_DEBUG, "ERROR: reader_a could not associate\n"));
+    return false;
+  }
+  if (!sdr_b.associate(writer_b, false /*active*/)) {
+    ACE_DEBUG((LM_DEBUG, "ERROR: reader_b could not associate\n"));
+    sdr_a.disassociate(writer_a.remote_id_);
+    return false;
+  }
+  reactor_wait(); // ACKNACKs sent on association
+
+  const size_t messages = part1.an_messages_,
+    submessages = part1.an_submessages_;
+  const SequenceNumber_t seq = {0, 1};
+  bool ok = part1.send_data(writer_a.remote_id_.entityId, seq, part2_addr)
+    && part1.send_data(writer_b.remote_id_.entityId, seq, part2_addr)
+    && part1.send_hb(writer_a.remote_id_.entityId, seq, seq, part2_addr)
+    && part1.send_hb(writer_b.remote_id_.entityId, seq, seq, part2_addr);
+  reactor_wait();
+
+  if (ok && (part1.an_submessages_ - submessages != 2
+             || part1.an_messages_ - messages != 1)) {
+    ACE_ERROR((LM_ERROR, "ERROR: got %B ACKNACKs in %B Messages, expected "
+               "2 in 1\n", part1.an_submessages_ - submessages,
+               part1.an_messages_ - messages));
+    ok = false;
+  }
+
+  sdr_a.disassociate(writer_a.remote_id_);
+  sdr_b.disassociate(writer_b.remote_id_);
+  return ok;
+}
+
+// Samples requested by repair_multicast_threshold_ readers are resent once
+// to the multicast group, the others to the readers that requested them,
+// and no more than max_repair_samples_ per retransmit cycle.  The group is
+// a plain socket here, which receives what the writer sends to the group.
+bool run_repair_test(TestParticipant& part1, SimpleDataWriter& sdw2,
+                     SequenceNumber& seq, const AssociationData& part1_reader,
+                     const ACE_INET_Addr& part2_addr)
+{
+  ACE_DEBUG((LM_INFO, ">>> Starting test of repair planning\n"));
+  TransportInst_rch inst = TheTransportRegistry->get_inst("my_rtps");
+  RtpsUdpInst* rtps_inst = dynamic_cast<RtpsUdpInst*>(inst.in());
+  if (!rtps_inst) {
+    std::cerr << "ERROR: Could not cast to RtpsUdpInst\n";
+    return false;
+  }
+
+  ACE_SOCK_Dgram part3_sock, group_sock;
+  ACE_INET_Addr part3_addr, group_addr;
+  if (!open_test_socket(part3_sock, part3_addr)
+      || !open_test_socket(group_sock, group_addr)) {
+    std::cerr << "ERROR: run_repair_test() unable to open sockets\n";
+    return false;
+  }
+
+  // A second reader of writer2, in its own participant
+  AssociationData part3_reader = part1_reader;
+  part3_reader.remote_id_.guidPrefix[11] ^= 0xff;
+  part3_reader.remote_id_.entityId.entityKey[2] = 8;
+  ACE_Message_Block mb_locator;
+  make_blob(part3_addr, mb_locator);
+  message_block_to_sequence(mb_locator, part3_reader.remote_data_[0].data);
+
+  TestParticipant part3(part3_sock, part3_reader.remote_id_.guidPrefix,
+                        part3_reader.remote_id_.entityId);
+  TestParticipant group(group_sock, part3_reader.remote_id_.guidPrefix,
+                        part3_reader.remote_id_.entityId);
+  part3.do_nack_ = group.do_nack_ = false;
+  part3.ack_all_ = true;
+  {
+    ReactorTask rt;
+    if (!sdw2.associate(part3_reader, true /*active*/)) {
+      ACE_DEBUG((LM_DEBUG, "ERROR: writer2 could not associate with "
+                 "reader3\n"));
+      return false;
+    }
+    rt.wait();
+  }
+  part3.ack_all_ = false;
+
+  const ACE_INET_Addr old_group = rtps_inst->multicast_group_address_;
+  rtps_inst->use_multicast_ = true;
+  rtps_inst->multicast_group_address_ = group_addr;
+
+  const SequenceNumber first = seq;
+  for (int i = 0; i < 6; ++i) {
+    sdw2.send_data(seq++);
+  }
+  reactor_wait();
+  SequenceNumber_t first_sn = {first.getHigh(), first.getLow()},
+    third_sn = first_sn;
+  third_sn.low += 2;
+  const OpenDDS::DCPS::EntityId_t& writer2 = sdw2.get_repo_id().entityId;
+
+  // Each case: the threshold, the sample limit, what part1 and part3
+  // request (first or third sample, number of samples) and how many
+  // samples part1, part3 and the group get again.
+  static const struct {
+    size_t threshold, max_samples;
+    bool part3_from_third;
+    CORBA::ULong part1_bits, part3_bits;
+    size_t part1_gets, part3_gets, group_gets;
+  } cases[] = {
+    {2, 0, false, 4, 4, 0, 0, 4}, // all requested by both
+    {3, 0, false, 4, 4, 4, 4, 0}, // below the threshold
+    {2, 0, true, 4, 4, 2, 2, 2},  // overlapping ranges are split
+    {0, 3, false, 4, 4, 3, 3, 0}, // limited to 3 samples
+    {0, 0, true, 0, 4, 0, 4, 0}   // only part3 requested
+  };
+
+  bool ok = true;
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    rtps_inst->repair_multicast_threshold_ = cases[i].threshold;
+    rtps_inst->max_repair_samples_ = cases[i].max_samples;
+    const size_t part1_before = part1.data_count_,
+      part3_before = part3.data_count_, group_before = group.data_count_;
+    if ((cases[i].part1_bits
+         && !part1.send_an(writer2, first_sn, part2_addr, true,
+                           cases[i].part1_bits))
+        || !part3.send_an(writer2,
+                          cases[i].part3_from_third ? third_sn : first_sn,
+                          part2_addr, true, cases[i].part3_bits)) {
+      ok = false;
+      break;
+    }
+    reactor_wait();
+    const size_t part1_got = part1.data_count_ - part1_before,
+      part3_got = part3.data_count_ - part3_before,
+      group_got = group.data_count_ - group_before;
+    if (part1_got != cases[i].part1_gets || part3_got != cases[i].part3_gets
+        || group_got != cases[i].group_gets) {
+      ACE_ERROR((LM_ERROR, "ERROR: repair case %B: reader1, reader3 and the "
+                 "group got %B, %B and %B samples, expected %B, %B and %B\n",
+                 i, part1_got, part3_got, group_got, cases[i].part1_gets,
+                 cases[i].part3_gets, cases[i].group_gets));
+      ok = false;
+    }
+  }
+
+  rtps_inst->repair_multicast_threshold_ = 0;
+  rtps_inst->max_repair_samples_ = 0;
+  rtps_inst->multicast_group_address_ = old_group;
+  rtps_inst->use_multicast_ = false;
+  sdw2.disassociate(part3_reader.remote_id_);
+  return ok;
+}
+
 bool run_test()
 {
   transport_setup();
@@ -777,16 +1226,10 @@ bool run_test()
 
   ACE_SOCK_Dgram part1_sock;
   ACE_INET_Addr part1_addr;
-  if (!open_appropriate_socket_type(part1_sock, part1_addr)) {
+  if (!open_test_socket(part1_sock, part1_addr)) {
     std::cerr << "ERROR: run_test() unable to open part1_sock" << std::endl;
     exit(1);
   }
-  part1_sock.get_local_addr(part1_addr);
-#ifdef OPENDDS_SAFETY_PROFILE
-  part1_addr.set(part1_addr.get_port_number(), "127.0.0.1");
-#else
-  part1_addr.set(part1_addr.get_port_number(), "localhost");
-#endif
   SimpleDataWriter sdw2(writer2);
   sdw2.enable_transport(true /*reliable*/, true /*durable*/);
 
@@ -963,10 +1406,20 @@ bool run_test()
     ACE_ERROR((LM_ERROR, "ERROR: reader1 did not receive expected data\n"));
   }
 
+  const bool held_ok = run_held_limit_test(part1, reader2, part1_writer,
+                                            part2_addr);
+  const bool filter_ok = run_data_filter_test(part1, sdr2, writer1,
+                                              part2_addr);
+  const bool backoff_ok = run_heartbeat_backoff_test(part1, sdw2, seq_dw2);
+  const bool bundle_ok = run_acknack_bundle_test(part1, reader2, part1_writer,
+                                                 part2_addr);
+  const bool repair_ok = run_repair_test(part1, sdw2, seq_dw2, part1_reader,
+                                         part2_addr);
+
   // cleanup
   sdw2.disassociate(reader1);
   sdr2.disassociate(writer1);
-  return true;
+  return held_ok && filter_ok && backoff_ok && bundle_ok && repair_ok;
 }
 
 int ACE_TMAIN(int /*argc*/, ACE_TCHAR* /*argv*/[])